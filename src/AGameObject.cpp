@@ -1,4 +1,10 @@
 #include "AGameObject.h"
+#include "SpriteBatch.h"
+#include "DrawList.h"
+#include "MathUtils.h"
+
+int AGameObject::transformUpdateCount = 0;
+float AGameObject::interpolationAlpha = 1.0f;
 
 AGameObject::AGameObject(String name)
 {
@@ -7,12 +13,6 @@ AGameObject::AGameObject(String name)
 }
 
 AGameObject::~AGameObject() {
-    if (this->sprite != nullptr) {
-        delete this->sprite;
-    }
-    if (this->texture != nullptr) {
-        delete this->texture;
-    }
 }
 
 AGameObject::String AGameObject::getName() {
@@ -20,47 +20,194 @@ AGameObject::String AGameObject::getName() {
 }
 
 void AGameObject::draw(sf::RenderWindow* targetWindow) {
-	if (this->sprite != NULL) {
-		this->sprite->setPosition(this->posX, this->posY);
-		this->sprite->setScale(this->scaleX, this->scaleY);
+	if (this->sprite.has_value()) {
+		this->updateTransform();
 		targetWindow->draw(*this->sprite);
 	}
 }
 
+void AGameObject::submit(SpriteBatch* batch) {
+	if (this->sprite.has_value()) {
+		this->updateTransform();
+		batch->submit(*this->sprite, static_cast<int>(this->renderLayer));
+	}
+}
+
+//the sprite is copied, the render thread may draw it while the object changes
+void AGameObject::record(DrawList* list) {
+	if (this->sprite.has_value()) {
+		this->updateTransform();
+		sf::Sprite sprite = *this->sprite;
+		list->addCustom([sprite](sf::RenderTarget& target) { target.draw(sprite); });
+	}
+}
+
+bool AGameObject::isBatchable() {
+	return true;
+}
+
+void AGameObject::setRenderLayer(RenderLayer layer)
+{
+	this->renderLayer = layer;
+}
+
+RenderLayer AGameObject::getRenderLayer()
+{
+	return this->renderLayer;
+}
+
 //must be called after being registered to the game object manager or one of the parent game objects
 void AGameObject::setPosition(float x, float y)
 {
 	this->posX = x;
 	this->posY = y;
-
-	if(this->sprite != nullptr)
-	{
-		this->sprite->setPosition(this->posX, this->posY);
-	}
+	this->transformDirty = true;
 }
 
 void AGameObject::setScale(float x, float y)
 {
 	this->scaleX = x;
 	this->scaleY = y;
-
-	if (this->sprite != nullptr)
-	{
-		this->sprite->setScale(this->scaleX, this->scaleY);
-	}
+	this->transformDirty = true;
 }
 
 sf::Vector2f AGameObject::getPosition()
 {
-	return this->sprite->getPosition();
+	return sf::Vector2f(this->posX, this->posY);
 }
 
 sf::Vector2f AGameObject::getScale()
 {
-	return this->sprite->getScale();
+	return sf::Vector2f(this->scaleX, this->scaleY);
 }
 
 sf::FloatRect AGameObject::getLocalBounds()
 {
-	return this->sprite->getLocalBounds();
+	return this->sprite.has_value() ? this->sprite->getLocalBounds() : sf::FloatRect();
+}
+
+sf::FloatRect AGameObject::getGlobalBounds()
+{
+	if (!this->sprite.has_value()) {
+		return sf::FloatRect(this->posX, this->posY, 0.0f, 0.0f);
+	}
+
+	this->updateTransform();
+	return this->sprite->getGlobalBounds();
+}
+
+void AGameObject::setNameIndexed(bool nameIndexed)
+{
+	this->nameIndexed = nameIndexed;
+}
+
+bool AGameObject::isNameIndexed()
+{
+	return this->nameIndexed;
+}
+
+void AGameObject::setThreadSafeUpdate(bool threadSafe)
+{
+	this->threadSafeUpdate = threadSafe;
+}
+
+bool AGameObject::isThreadSafeUpdate()
+{
+	return this->threadSafeUpdate;
+}
+
+void AGameObject::setUpdateGroup(int group)
+{
+	this->updateGroup = group;
+}
+
+int AGameObject::getUpdateGroup()
+{
+	return this->updateGroup;
+}
+
+void AGameObject::setHandle(ObjectHandle handle, unsigned int addOrder)
+{
+	this->handle = handle;
+	this->addOrder = addOrder;
+}
+
+ObjectHandle AGameObject::getHandle()
+{
+	return this->handle;
+}
+
+unsigned int AGameObject::getAddOrder()
+{
+	return this->addOrder;
+}
+
+sf::Sprite* AGameObject::getSprite()
+{
+	if (!this->sprite.has_value()) {
+		this->sprite.emplace();
+		this->transformDirty = true;
+	}
+
+	return &*this->sprite;
+}
+
+sf::Texture* AGameObject::getOwnedTexture()
+{
+	if (this->ownedTexture == nullptr) {
+		this->ownedTexture = std::make_unique<sf::Texture>();
+	}
+
+	return this->ownedTexture.get();
+}
+
+int AGameObject::getTransformUpdateCount()
+{
+	return transformUpdateCount;
+}
+
+void AGameObject::resetTransformUpdateCount()
+{
+	transformUpdateCount = 0;
+}
+
+void AGameObject::beginFixedStep()
+{
+	this->previousPosX = this->posX;
+	this->previousPosY = this->posY;
+	this->hasPreviousPosition = true;
+}
+
+void AGameObject::setInterpolationAlpha(float alpha)
+{
+	interpolationAlpha = alpha;
+}
+
+float AGameObject::getInterpolationAlpha()
+{
+	return interpolationAlpha;
+}
+
+void AGameObject::updateTransform()
+{
+	if (!this->sprite.has_value()) {
+		return;
+	}
+
+	//an object that moved during the last step has to be rewritten every frame until it comes to rest
+	bool moving = this->hasPreviousPosition && (this->previousPosX != this->posX || this->previousPosY != this->posY);
+	if (!this->transformDirty && !moving) {
+		return;
+	}
+
+	if (moving) {
+		this->sprite->setPosition(MathUtils::lerp(this->previousPosX, this->posX, interpolationAlpha),
+			MathUtils::lerp(this->previousPosY, this->posY, interpolationAlpha));
+	}
+	else {
+		this->sprite->setPosition(this->posX, this->posY);
+	}
+	this->sprite->setScale(this->scaleX, this->scaleY);
+	this->transformDirty = moving;
+	transformUpdateCount++;
 }
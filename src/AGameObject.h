@@ -1,32 +1,103 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include <optional>
 #include <string>
+#include "ObjectHandle.h"
+
+class SpriteBatch;
+class DrawList;
+
+//objects are drawn layer by layer, lowest first
+enum class RenderLayer
+{
+	Background,
+	World,
+	Overlay,
+	UI
+};
+const int RENDER_LAYER_COUNT = static_cast<int>(RenderLayer::UI) + 1;
 
 class AGameObject: sf::NonCopyable
 {
 	public:
 		typedef std::string String;
 		AGameObject(String name);
-		~AGameObject();
+		virtual ~AGameObject(); //the manager deletes objects through this base
 		virtual void initialize() = 0;
 		virtual void processInput(sf::Event event) = 0;
 		virtual void update(sf::Time deltaTime) = 0;
 		virtual void draw(sf::RenderWindow* targetWindow);
+		virtual void submit(SpriteBatch* batch); //batched counterpart of draw
+		virtual bool isBatchable(); //objects that draw text or custom drawables return false and keep using draw
+		virtual void record(DrawList* list); //render thread counterpart of draw for unbatched objects
 		String getName();
 
+		void setRenderLayer(RenderLayer layer);
+		RenderLayer getRenderLayer();
+
 		virtual void setPosition(float x, float y);
 		virtual void setScale(float x, float y);
 		virtual sf::FloatRect getLocalBounds();
+		virtual sf::FloatRect getGlobalBounds();
 		virtual sf::Vector2f getPosition();
 		virtual sf::Vector2f getScale();
 
+		//only objects that are looked up by name go into GameObjectManager's name index. set before adding the object.
+		void setNameIndexed(bool nameIndexed);
+		bool isNameIndexed();
+
+		//objects whose update only touches their own state may be updated on worker threads. objects that share state
+		//can be put in the same update group instead. in every step:
+		// - opted-in objects are updated first, and all of them have finished before any other object is updated
+		// - a group is updated by one thread, in the order its objects were added
+		// - thread-safe objects outside a group have no order among themselves or against the groups
+		// - all other objects are updated on the main thread, in the order they were added
+		//this holds whether or not the pool is used. flags may change between steps.
+		void setThreadSafeUpdate(bool threadSafe);
+		bool isThreadSafeUpdate();
+		void setUpdateGroup(int group); //0 = no group
+		int getUpdateGroup();
+
+		void setHandle(ObjectHandle handle, unsigned int addOrder); //bookkeeping for GameObjectManager
+		ObjectHandle getHandle();
+		unsigned int getAddOrder();
+
+		//remembers where the object was before the next fixed step, objects that move are drawn between the two
+		void beginFixedStep();
+		static void setInterpolationAlpha(float alpha); //set by GameObjectManager before drawing
+		static float getInterpolationAlpha();
+
+		//sprite transforms written since the last reset; GameObjectManager resets it every frame
+		static int getTransformUpdateCount();
+		static void resetTransformUpdateCount();
 
 	protected:
 		String name;
-		sf::Sprite* sprite = new sf::Sprite();
-		sf::Texture* texture = new sf::Texture();
+		//objects that never draw a sprite or own a texture do not allocate either
+		std::optional<sf::Sprite> sprite;
+		std::unique_ptr<sf::Texture> ownedTexture;
+		sf::Sprite* getSprite(); //creates the sprite on first use
+		sf::Texture* getOwnedTexture();
 
 		float posX = 0.0f; float posY = 0.0f;
 		float scaleX = 1.0f; float scaleY = 1.0f;
+		RenderLayer renderLayer = RenderLayer::World;
+
+		//position and scale only reach the sprite when it is about to be used
+		bool transformDirty = true;
+		void updateTransform();
+		static int transformUpdateCount;
+
+		//only the position is interpolated, scale changes show up on the step that made them
+		float previousPosX = 0.0f; float previousPosY = 0.0f;
+		bool hasPreviousPosition = false;
+		static float interpolationAlpha;
+
+		bool nameIndexed = false;
+		bool threadSafeUpdate = false;
+		int updateGroup = 0;
+		ObjectHandle handle;
+		unsigned int addOrder = 0;
 };
 
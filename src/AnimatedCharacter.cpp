@@ -5,6 +5,9 @@
 
 AnimatedCharacter::AnimatedCharacter(String name) : AGameObject(name)
 {
+    this->setNameIndexed(true);
+    this->setThreadSafeUpdate(true); // Only advances its own animation
+    this->setRenderLayer(RenderLayer::Overlay);
 }
 
 void AnimatedCharacter::initialize()
@@ -16,9 +19,9 @@ void AnimatedCharacter::initialize()
     // Set initial position
     this->setPosition(startX, yPosition);
 
-    if (!animationFrames.empty() && this->sprite != nullptr)
+    if (!animationFrames.empty())
     {
-        this->sprite->setTexture(*animationFrames[0]);
+        this->getSprite()->setTexture(*animationFrames[0]);
         this->sprite->setScale(2.0f, 2.0f); // Make it bigger if needed
     }
 }
@@ -70,7 +73,7 @@ void AnimatedCharacter::updateAnimation(sf::Time deltaTime)
         // Move to next frame
         currentFrame = (currentFrame + 1) % animationFrames.size();
 
-        if (this->sprite != nullptr)
+        if (this->sprite.has_value())
         {
             this->sprite->setTexture(*animationFrames[currentFrame]);
         }
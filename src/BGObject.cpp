@@ -2,24 +2,18 @@
 #include <iostream>
 #include "TextureManager.h"
 #include "BaseRunner.h"
+#include "SpriteBatch.h"
+#include "CameraManager.h"
+#include "DrawList.h"
 
 BGObject::BGObject(string name) : AGameObject(name)
 {
+    this->setNameIndexed(true);
+    this->setRenderLayer(RenderLayer::Background);
 }
 
 BGObject::~BGObject()
 {
-    if (bg2Sprite != nullptr)
-    {
-        delete bg2Sprite;
-        bg2Sprite = nullptr;
-    }
-
-    if (whiteOverlay != nullptr)
-    {
-        delete whiteOverlay;
-        whiteOverlay = nullptr;
-    }
 }
 
 void BGObject::initialize()
@@ -32,40 +26,26 @@ void BGObject::initialize()
     if (bg1Texture != nullptr)
     {
         bg1Texture->setRepeated(true);
-        this->sprite->setTexture(*bg1Texture);
-        this->sprite->setTextureRect(sf::IntRect(0, 0, BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT * 8));
-        this->setPosition(0, -BaseRunner::WINDOW_HEIGHT * 7);
+        baseLayer = addParallaxLayer(bg1Texture, PARALLAX_FACTOR);
     }
     else
     {
         std::cout << "Warning: Failed to load bg1!" << std::endl;
     }
 
-    // Load bg2 and prepare sprite
+    // Load bg2, only shown through the transition until it becomes the base layer
     bg2Texture = TextureManager::getInstance()->getFromTextureMap("bg2", 0);
 
     if (bg2Texture != nullptr)
     {
         bg2Texture->setRepeated(true);
-        bg2Sprite = new sf::Sprite();
-        bg2Sprite->setTexture(*bg2Texture);
-        bg2Sprite->setTextureRect(sf::IntRect(0, 0, BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT * 8));
-        bg2Sprite->setPosition(0, -BaseRunner::WINDOW_HEIGHT * 7);
-
-        // Start invisible
-        sf::Color color = bg2Sprite->getColor();
-        color.a = 0;
-        bg2Sprite->setColor(color);
+        bg2Layer = addParallaxLayer(bg2Texture, PARALLAX_FACTOR);
+        setParallaxLayerVisible(bg2Layer, false);
     }
     else
     {
         std::cout << "Warning: Failed to load bg2!" << std::endl;
     }
-
-    // Create white overlay sprite for fade effect
-    whiteOverlay = new sf::RectangleShape(sf::Vector2f(BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT));
-    whiteOverlay->setFillColor(sf::Color(255, 255, 255, 0)); // Start transparent
-    whiteOverlay->setPosition(0, 0);
 }
 
 void BGObject::processInput(sf::Event event)
@@ -82,45 +62,116 @@ void BGObject::update(sf::Time deltaTime)
 
 void BGObject::draw(sf::RenderWindow* targetWindow)
 {
-    // Draw bg1 first
-    if (this->sprite != nullptr)
+    updateScrollOffset();
+    sf::FloatRect screenRect(0.0f, 0.0f, BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT);
+
+    for (int i = 0; i < parallaxLayers.size(); i++)
     {
-        targetWindow->draw(*this->sprite);
+        // The base layer and bg2 go through the compositor while the transition runs
+        if (isFading && i == baseLayer && bg2Layer >= 0)
+        {
+            transitionCompositor.draw(*targetWindow, getTransitionSource(baseLayer), getTransitionSource(bg2Layer), screenRect, fadeProgress, transitionType);
+            continue;
+        }
+
+        drawLayer(targetWindow, parallaxLayers[i]);
+    }
+}
+
+void BGObject::record(DrawList* list)
+{
+    updateScrollOffset();
+    sf::FloatRect screenRect(0.0f, 0.0f, BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT);
+
+    for (int i = 0; i < parallaxLayers.size(); i++)
+    {
+        // Only the render thread uses the compositor while it runs, everything else is copied
+        if (isFading && i == baseLayer && bg2Layer >= 0)
+        {
+            TransitionCompositor* compositor = &transitionCompositor;
+            TransitionCompositor::Source from = getTransitionSource(baseLayer);
+            TransitionCompositor::Source to = getTransitionSource(bg2Layer);
+            float progress = fadeProgress;
+            TransitionCompositor::Type type = transitionType;
+            list->addCustom([compositor, from, to, screenRect, progress, type](sf::RenderTarget& target) {
+                compositor->draw(target, from, to, screenRect, progress, type);
+            });
+            continue;
+        }
+
+        const ParallaxLayer& layer = parallaxLayers[i];
+        if (layer.visible && layer.texture != nullptr)
+        {
+            sf::Vertex quad[6];
+            buildLayerQuad(layer, quad);
+            list->addVertices(quad, 6, layer.texture);
+        }
     }
+}
+
+void BGObject::submit(SpriteBatch* batch)
+{
+    updateScrollOffset();
+    int layer = static_cast<int>(this->renderLayer);
+    sf::FloatRect screenRect(0.0f, 0.0f, BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT);
 
-    // Draw bg2 underneath white overlay during transition
-    if (isFading && bg2Sprite != nullptr && fadeProgress >= 0.5f)
+    for (const ParallaxLayer& parallaxLayer : parallaxLayers)
     {
-        targetWindow->draw(*bg2Sprite);
+        if (parallaxLayer.visible && parallaxLayer.texture != nullptr)
+        {
+            batch->submitRect(parallaxLayer.texture, screenRect, getLayerTextureRect(parallaxLayer), sf::Color::White, layer);
+        }
     }
+}
 
-    // Draw white overlay on top
-    if (isFading && whiteOverlay != nullptr)
+// The transition is a shader pass, so it cannot go through the sprite batch
+bool BGObject::isBatchable()
+{
+    return !isFading;
+}
+
+int BGObject::addParallaxLayer(sf::Texture* texture, float speedFactor)
+{
+    ParallaxLayer layer;
+    layer.texture = texture;
+    layer.speedFactor = speedFactor;
+    parallaxLayers.push_back(layer);
+    return static_cast<int>(parallaxLayers.size()) - 1;
+}
+
+void BGObject::setParallaxLayerTexture(int layerIndex, sf::Texture* texture)
+{
+    if (layerIndex >= 0 && layerIndex < parallaxLayers.size())
     {
-        targetWindow->draw(*whiteOverlay);
+        parallaxLayers[layerIndex].texture = texture;
     }
 }
 
-void BGObject::startTransitionToBg2()
+void BGObject::setParallaxLayerVisible(int layerIndex, bool visible)
 {
-    if (bg2Texture == nullptr || bg2Sprite == nullptr)
+    if (layerIndex >= 0 && layerIndex < parallaxLayers.size())
+    {
+        parallaxLayers[layerIndex].visible = visible;
+    }
+}
+
+void BGObject::startTransitionToBg2(TransitionCompositor::Type type)
+{
+    if (bg2Texture == nullptr || bg2Layer < 0)
     {
         std::cout << "Cannot transition - bg2 not loaded!" << std::endl;
         return;
     }
 
-    std::cout << "Starting white fade transition to bg2..." << std::endl;
+    std::cout << "Starting " << TransitionCompositor::getTypeName(type) << " transition to bg2..." << std::endl;
+    transitionType = type;
     isFading = true;
     fadeProgress = 0.0f;
-
-    // Make bg2 fully visible (it will be revealed as white fades)
-    sf::Color color = bg2Sprite->getColor();
-    color.a = 255;
-    bg2Sprite->setColor(color);
 }
 
 void BGObject::updateFade(float deltaTime)
 {
+    // The compositor reads fadeProgress directly; only the end of the transition changes any state
     fadeProgress += deltaTime / FADE_DURATION;
 
     if (fadeProgress >= 1.0f)
@@ -129,28 +180,78 @@ void BGObject::updateFade(float deltaTime)
         fadeProgress = 1.0f;
         isFading = false;
 
-        // Swap to bg2 as main background
-        this->sprite->setTexture(*bg2Texture);
-
-        // Make white overlay invisible
-        whiteOverlay->setFillColor(sf::Color(255, 255, 255, 0));
-
-        std::cout << "Fade to bg2 complete!" << std::endl;
-    }
-    else
-    {
-        // White fade effect: fade to white in first half, fade from white in second half
-        if (fadeProgress <= 0.5f)
+        // Swap to bg2 as main background (bg2 keeps its own layer if bg1 never loaded)
+        if (baseLayer >= 0)
         {
-            // First half: fade TO white (alpha increases)
-            float alpha = (fadeProgress / 0.5f) * 255.0f;
-            whiteOverlay->setFillColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha)));
+            setParallaxLayerTexture(baseLayer, bg2Texture);
         }
         else
         {
-            // Second half: fade FROM white (alpha decreases)
-            float alpha = ((1.0f - fadeProgress) / 0.5f) * 255.0f;
-            whiteOverlay->setFillColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha)));
+            setParallaxLayerVisible(bg2Layer, true);
         }
+
+        std::cout << "Fade to bg2 complete!" << std::endl;
     }
-}
\ No newline at end of file
+}
+
+void BGObject::updateScrollOffset()
+{
+    // Follow the world camera, if the icon grid has one
+    Camera* worldCamera = CameraManager::getInstance()->getLayerCamera(RenderLayer::World);
+    if (worldCamera == nullptr)
+    {
+        return;
+    }
+
+    sf::Vector2f screenCenter(BaseRunner::WINDOW_WIDTH / 2.0f, BaseRunner::WINDOW_HEIGHT / 2.0f);
+    // Same interpolated view the world layer is drawn through, so the layers cannot drift apart between steps
+    scrollOffset = worldCamera->getInterpolatedView(getInterpolationAlpha()).getCenter() - screenCenter;
+}
+
+void BGObject::drawLayer(sf::RenderWindow* targetWindow, const ParallaxLayer& layer)
+{
+    if (!layer.visible || layer.texture == nullptr)
+    {
+        return;
+    }
+
+    sf::Vertex quad[6];
+    buildLayerQuad(layer, quad);
+    targetWindow->draw(quad, 6, sf::Triangles, sf::RenderStates(layer.texture));
+}
+
+void BGObject::buildLayerQuad(const ParallaxLayer& layer, sf::Vertex* quad) const
+{
+    sf::FloatRect texRect = getLayerTextureRect(layer);
+    float right = BaseRunner::WINDOW_WIDTH;
+    float bottom = BaseRunner::WINDOW_HEIGHT;
+
+    sf::Vertex topLeft(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(texRect.left, texRect.top));
+    sf::Vertex bottomLeft(sf::Vector2f(0.0f, bottom), sf::Vector2f(texRect.left, texRect.top + texRect.height));
+    sf::Vertex topRight(sf::Vector2f(right, 0.0f), sf::Vector2f(texRect.left + texRect.width, texRect.top));
+    sf::Vertex bottomRight(sf::Vector2f(right, bottom), sf::Vector2f(texRect.left + texRect.width, texRect.top + texRect.height));
+
+    quad[0] = topLeft;
+    quad[1] = bottomLeft;
+    quad[2] = topRight;
+    quad[3] = topRight;
+    quad[4] = bottomLeft;
+    quad[5] = bottomRight;
+}
+
+TransitionCompositor::Source BGObject::getTransitionSource(int layerIndex) const
+{
+    TransitionCompositor::Source source;
+    source.texture = parallaxLayers[layerIndex].texture;
+    source.textureRect = getLayerTextureRect(parallaxLayers[layerIndex]);
+    return source;
+}
+
+sf::FloatRect BGObject::getLayerTextureRect(const ParallaxLayer& layer) const
+{
+    // The old 8-screen sprites showed the bottom screen of the texture; keep starting there
+    sf::Vector2f baseOffset(0.0f, BaseRunner::WINDOW_HEIGHT * 7.0f);
+
+    return sf::FloatRect(baseOffset.x + scrollOffset.x * layer.speedFactor, baseOffset.y + scrollOffset.y * layer.speedFactor,
+        BaseRunner::WINDOW_WIDTH, BaseRunner::WINDOW_HEIGHT);
+}
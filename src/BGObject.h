@@ -1,5 +1,7 @@
 #pragma once
 #include "AGameObject.h"
+#include "TransitionCompositor.h"
+#include <vector>
 
 class BGObject : public AGameObject
 {
@@ -10,19 +12,46 @@ public:
     void processInput(sf::Event event);
     void update(sf::Time deltaTime);
     void draw(sf::RenderWindow* targetWindow) override;
-    void startTransitionToBg2();
+    void submit(SpriteBatch* batch) override;
+    bool isBatchable() override;
+    void record(DrawList* list) override;
+    void startTransitionToBg2(TransitionCompositor::Type type = TransitionCompositor::Type::WhiteFade);
+
+    // Layers are drawn in the order they were added. speedFactor is how far the layer scrolls per pixel the world camera moves.
+    int addParallaxLayer(sf::Texture* texture, float speedFactor);
+    void setParallaxLayerTexture(int layerIndex, sf::Texture* texture);
+    void setParallaxLayerVisible(int layerIndex, bool visible);
 
 private:
-    const float SPEED_MULTIPLIER = 500.0f;
+    // Each layer is one screen-sized quad; scrolling only moves its texture coordinates over a repeated texture
+    struct ParallaxLayer
+    {
+        sf::Texture* texture = nullptr;
+        float speedFactor = 1.0f;
+        bool visible = true;
+    };
+
+    const float PARALLAX_FACTOR = 0.25f; // Background moves at a quarter of the icon grid's scroll speed
     const float FADE_DURATION = 2.0f; // Fade takes 2 seconds
 
+    std::vector<ParallaxLayer> parallaxLayers;
+    sf::Vector2f scrollOffset; // World camera movement since it started
+
     sf::Texture* bg1Texture = nullptr;
     sf::Texture* bg2Texture = nullptr;
-    sf::Sprite* bg2Sprite = nullptr;
-    sf::RectangleShape* whiteOverlay = nullptr; // NEW: White fade overlay
+    int baseLayer = -1;
+    int bg2Layer = -1;
 
+    // bg1 -> bg2 is blended in one full-screen pass instead of layering both backgrounds and a white overlay
+    TransitionCompositor transitionCompositor;
+    TransitionCompositor::Type transitionType = TransitionCompositor::Type::WhiteFade;
     bool isFading = false;
     float fadeProgress = 0.0f;
 
     void updateFade(float deltaTime);
-};
\ No newline at end of file
+    void updateScrollOffset();
+    void drawLayer(sf::RenderWindow* targetWindow, const ParallaxLayer& layer);
+    void buildLayerQuad(const ParallaxLayer& layer, sf::Vertex* quad) const; // 6 vertices, two triangles
+    TransitionCompositor::Source getTransitionSource(int layerIndex) const;
+    sf::FloatRect getLayerTextureRect(const ParallaxLayer& layer) const;
+};
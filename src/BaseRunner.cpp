@@ -7,6 +7,9 @@
 #include "MusicManager.h"
 #include "LoadingText.h"
 #include "PokeballAnimation.h"
+#include "MainThreadDispatcher.h"
+#include "CameraManager.h"
+#include <iostream>
 
 
 
@@ -16,8 +19,9 @@ const float FRAME_RATE = 60.f;
 /// </summary>
 const sf::Time BaseRunner::TIME_PER_FRAME = sf::seconds(1.f / 60.f);
 
-BaseRunner::BaseRunner() :
-	window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "HO: Entity Component", sf::Style::Close) {
+BaseRunner::BaseRunner(bool useRenderThread) :
+	window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "HO: Entity Component", sf::Style::Close),
+	framePacer(TIME_PER_FRAME, MAX_CATCH_UP_STEPS) {
 	//load initial textures
 	TextureManager::getInstance()->loadFromAssetList();
 
@@ -26,6 +30,10 @@ BaseRunner::BaseRunner() :
 	MusicManager::getInstance()->setLoop(true); // Loop forever
 	MusicManager::getInstance()->play();
 
+	//the icon grid scrolls by moving this camera, everything else uses the default view
+	CameraManager::getInstance()->createCamera("World", sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+	CameraManager::getInstance()->bindLayer(RenderLayer::World, "World");
+
 	LoadingText* loadingText = new LoadingText("LoadingText");
 	GameObjectManager::getInstance()->addObject(loadingText);
 
@@ -38,26 +46,61 @@ BaseRunner::BaseRunner() :
 
 	FPSCounter* fpsCounter = new FPSCounter();
 	GameObjectManager::getInstance()->addObject(fpsCounter);
+
+	//initialize everything now rather than on the first update
+	GameObjectManager::getInstance()->applyPendingChanges();
+
+	if (useRenderThread) {
+		this->renderThread = std::make_unique<RenderThread>();
+	}
+}
+
+void BaseRunner::setFrameLimit(FramePacer::LimitMode mode, unsigned int framesPerSecond) {
+	this->window.setVerticalSyncEnabled(mode == FramePacer::LimitMode::VSync);
+	this->framePacer.setLimit(mode, framesPerSecond);
 }
 
 void BaseRunner::run() {
-	sf::Clock clock;
-	sf::Time timeSinceLastUpdate = sf::Time::Zero;
+	if (this->renderThread) {
+		this->renderThread->start(&this->window);
+	}
+
 	while (this->window.isOpen())
 	{
-		sf::Time elapsedTime = clock.restart();
-		timeSinceLastUpdate += elapsedTime;
-		while (timeSinceLastUpdate > TIME_PER_FRAME)
+		//after a long stall only MAX_CATCH_UP_STEPS are simulated, the rest of the backlog is dropped
+		this->framePacer.beginFrame();
+		while (this->framePacer.consumeStep())
 		{
-			timeSinceLastUpdate -= TIME_PER_FRAME;
-
 			processEvents();
 			update(TIME_PER_FRAME);
 			//update(elapsedTime);
 		}
 
-		render();
+		//continuations posted to the main thread. decoded streaming assets become textures on the thread that owns
+		//the GL context: here, or at the start of the recorded frame when the render thread has it
+		MainThreadDispatcher::getInstance()->drainTasks();
+		if (!this->renderThread) {
+			TextureManager::getInstance()->processPendingUploads();
+		}
+
+		float interpolationAlpha = this->framePacer.getInterpolationAlpha();
+		if (this->renderThread) {
+			recordFrame(interpolationAlpha);
+		}
+		else {
+			render(interpolationAlpha);
+		}
+
+		this->framePacer.endFrame();
+	}
+
+	if (this->renderThread) {
+		this->renderThread->stop();
 	}
+	GameObjectManager::getInstance()->shutdown();
+
+	std::cout << "[BaseRunner] Catch-up was clamped in " << this->framePacer.getClampedFrameCount() << " frames, dropping "
+		<< this->framePacer.getDroppedTime().asSeconds() << "s of simulation" << std::endl;
 }
 
 void BaseRunner::processEvents()
@@ -68,6 +111,10 @@ void BaseRunner::processEvents()
 		
 		default: GameObjectManager::getInstance()->processInput(event); break;
 		case sf::Event::Closed:
+			//the render thread must let go of the window before it closes
+			if (this->renderThread) {
+				this->renderThread->stop();
+			}
 			this->window.close();
 			break;
 
@@ -77,10 +124,24 @@ void BaseRunner::processEvents()
 
 void BaseRunner::update(sf::Time elapsedTime) {
 	GameObjectManager::getInstance()->update(elapsedTime);
+	CameraManager::getInstance()->update(elapsedTime);
 }
 
-void BaseRunner::render() {
+void BaseRunner::render(float interpolationAlpha) {
 	this->window.clear();
-	GameObjectManager::getInstance()->draw(&this->window);
+	GameObjectManager::getInstance()->draw(&this->window, interpolationAlpha);
 	this->window.display();
-}
\ No newline at end of file
+}
+
+void BaseRunner::recordFrame(float interpolationAlpha) {
+	DrawList* list = this->renderThread->acquireDrawList();
+	if (list == NULL) {
+		return;
+	}
+
+	//runs on the render thread before anything in this frame is drawn
+	list->addCustom([](sf::RenderTarget&) { TextureManager::getInstance()->processPendingUploads(); });
+
+	GameObjectManager::getInstance()->recordDrawList(list, this->window.getDefaultView(), interpolationAlpha);
+	this->renderThread->submitDrawList(list);
+}
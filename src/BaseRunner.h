@@ -1,5 +1,8 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <memory>
+#include "RenderThread.h"
+#include "FramePacer.h"
 
 using namespace std;
 class BaseRunner : private sf::NonCopyable
@@ -9,14 +12,20 @@ public:
 	static const int WINDOW_WIDTH = 1920;
 	static const int WINDOW_HEIGHT = 1080;
 
-	BaseRunner();
+	static const int MAX_CATCH_UP_STEPS = 5;
+
+	BaseRunner(bool useRenderThread = false); //the render thread draws recorded frames while the next one updates
+	void setFrameLimit(FramePacer::LimitMode mode, unsigned int framesPerSecond = 60); //call before run
 	void run();
 
 private:
 	
 	sf::RenderWindow		window;
+	std::unique_ptr<RenderThread> renderThread;
+	FramePacer framePacer;
 
-	void render();
+	void render(float interpolationAlpha);
+	void recordFrame(float interpolationAlpha);
 	void processEvents();
 	void update(sf::Time elapsedTime);
 };
@@ -0,0 +1,167 @@
+#include "Camera.h"
+#include <algorithm>
+
+Camera::Camera(sf::Vector2f viewSize)
+{
+	this->viewSize = viewSize;
+	this->center = sf::Vector2f(viewSize.x / 2.0f, viewSize.y / 2.0f);
+	this->applyView();
+	this->previousViewCenter = this->view.getCenter();
+}
+
+void Camera::update(sf::Time deltaTime)
+{
+	this->previousViewCenter = this->view.getCenter();
+
+	if (!this->isAnimating()) {
+		return;
+	}
+
+	if (this->zoomTween.active) {
+		this->zoom = advance(this->zoomTween, deltaTime.asSeconds()).x;
+	}
+	if (this->panTween.active) {
+		this->center = advance(this->panTween, deltaTime.asSeconds());
+	}
+
+	this->applyView();
+}
+
+const sf::View& Camera::getView() const
+{
+	return this->view;
+}
+
+sf::View Camera::getInterpolatedView(float alpha) const
+{
+	sf::View interpolated = this->view;
+	sf::Vector2f current = this->view.getCenter();
+	interpolated.setCenter(MathUtils::lerp(this->previousViewCenter.x, current.x, alpha),
+		MathUtils::lerp(this->previousViewCenter.y, current.y, alpha));
+	return interpolated;
+}
+
+void Camera::setCenter(sf::Vector2f center)
+{
+	this->panTween.active = false;
+	this->center = center;
+	this->applyView();
+	this->previousViewCenter = this->view.getCenter(); //a jump is not interpolated
+}
+
+sf::Vector2f Camera::getCenter() const
+{
+	return this->view.getCenter();
+}
+
+void Camera::panTo(sf::Vector2f center, float duration, MathUtils::Easing easing)
+{
+	if (duration <= 0.0f) {
+		this->setCenter(center);
+		return;
+	}
+
+	//start from where the camera actually is, clamping included
+	this->panTween.active = true;
+	this->panTween.from = this->view.getCenter();
+	this->panTween.to = center;
+	this->panTween.elapsed = 0.0f;
+	this->panTween.duration = duration;
+	this->panTween.easing = easing;
+}
+
+void Camera::panBy(sf::Vector2f offset, float duration, MathUtils::Easing easing)
+{
+	sf::Vector2f target = this->panTween.active ? this->panTween.to : this->center;
+	this->panTo(target + offset, duration, easing);
+}
+
+void Camera::setZoom(float zoom)
+{
+	this->zoomTween.active = false;
+	this->zoom = zoom;
+	this->applyView();
+}
+
+float Camera::getZoom() const
+{
+	return this->zoom;
+}
+
+void Camera::zoomTo(float zoom, float duration, MathUtils::Easing easing)
+{
+	if (duration <= 0.0f) {
+		this->setZoom(zoom);
+		return;
+	}
+
+	this->zoomTween.active = true;
+	this->zoomTween.from = sf::Vector2f(this->zoom, 0.0f);
+	this->zoomTween.to = sf::Vector2f(zoom, 0.0f);
+	this->zoomTween.elapsed = 0.0f;
+	this->zoomTween.duration = duration;
+	this->zoomTween.easing = easing;
+}
+
+void Camera::setContentBounds(const sf::FloatRect& bounds)
+{
+	this->hasContentBounds = true;
+	this->contentBounds = bounds;
+	this->applyView();
+	this->previousViewCenter = this->view.getCenter();
+}
+
+void Camera::clearContentBounds()
+{
+	this->hasContentBounds = false;
+	this->applyView();
+	this->previousViewCenter = this->view.getCenter();
+}
+
+bool Camera::isAnimating() const
+{
+	return this->panTween.active || this->zoomTween.active;
+}
+
+sf::Vector2f Camera::advance(Tween& tween, float deltaTime)
+{
+	tween.elapsed += deltaTime;
+	float t = MathUtils::ease(tween.easing, tween.elapsed / tween.duration);
+	if (tween.elapsed >= tween.duration) {
+		tween.active = false;
+	}
+
+	return sf::Vector2f(MathUtils::lerp(tween.from.x, tween.to.x, t), MathUtils::lerp(tween.from.y, tween.to.y, t));
+}
+
+void Camera::applyView()
+{
+	this->view.setSize(this->viewSize.x * this->zoom, this->viewSize.y * this->zoom);
+	this->view.setCenter(this->clampCenter(this->center));
+}
+
+sf::Vector2f Camera::clampCenter(sf::Vector2f target) const
+{
+	if (!this->hasContentBounds) {
+		return target;
+	}
+
+	sf::Vector2f halfSize(this->view.getSize().x / 2.0f, this->view.getSize().y / 2.0f);
+	sf::Vector2f clamped = target;
+
+	if (this->contentBounds.width <= halfSize.x * 2.0f) {
+		clamped.x = this->contentBounds.left + this->contentBounds.width / 2.0f;
+	}
+	else {
+		clamped.x = std::clamp(target.x, this->contentBounds.left + halfSize.x, this->contentBounds.left + this->contentBounds.width - halfSize.x);
+	}
+
+	if (this->contentBounds.height <= halfSize.y * 2.0f) {
+		clamped.y = this->contentBounds.top + this->contentBounds.height / 2.0f;
+	}
+	else {
+		clamped.y = std::clamp(target.y, this->contentBounds.top + halfSize.y, this->contentBounds.top + this->contentBounds.height - halfSize.y);
+	}
+
+	return clamped;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "MathUtils.h"
+
+/* A view into the world that can be moved and zoomed, either directly or with an eased animation.
+ * With content bounds set, the visible area never leaves them; content smaller than the view is centered.
+ */
+class Camera
+{
+public:
+	Camera(sf::Vector2f viewSize);
+
+	void update(sf::Time deltaTime);
+	const sf::View& getView() const;
+	sf::View getInterpolatedView(float alpha) const; //between the view before and after the last update
+
+	void setCenter(sf::Vector2f center); //stops any running pan
+	sf::Vector2f getCenter() const;
+	void panTo(sf::Vector2f center, float duration, MathUtils::Easing easing = MathUtils::Easing::QuadInOut);
+	void panBy(sf::Vector2f offset, float duration, MathUtils::Easing easing = MathUtils::Easing::QuadInOut);
+
+	void setZoom(float zoom); //1 shows viewSize world units, 2 shows twice as much
+	float getZoom() const;
+	void zoomTo(float zoom, float duration, MathUtils::Easing easing = MathUtils::Easing::QuadInOut);
+
+	void setContentBounds(const sf::FloatRect& bounds);
+	void clearContentBounds();
+
+	bool isAnimating() const;
+
+private:
+	struct Tween
+	{
+		bool active = false;
+		sf::Vector2f from;
+		sf::Vector2f to;
+		float elapsed = 0.0f;
+		float duration = 0.0f;
+		MathUtils::Easing easing = MathUtils::Easing::Linear;
+	};
+
+	sf::View view;
+	sf::Vector2f viewSize;
+	sf::Vector2f center;
+	float zoom = 1.0f;
+	sf::Vector2f previousViewCenter;
+
+	Tween panTween;
+	Tween zoomTween; //only x is used
+
+	bool hasContentBounds = false;
+	sf::FloatRect contentBounds;
+
+	static sf::Vector2f advance(Tween& tween, float deltaTime);
+	void applyView();
+	sf::Vector2f clampCenter(sf::Vector2f target) const;
+};
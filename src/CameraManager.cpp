@@ -0,0 +1,51 @@
+#include "CameraManager.h"
+#include <iostream>
+
+CameraManager* CameraManager::sharedInstance = NULL;
+
+CameraManager* CameraManager::getInstance() {
+	if (sharedInstance == NULL) {
+		//initialize
+		sharedInstance = new CameraManager();
+	}
+
+	return sharedInstance;
+}
+
+Camera* CameraManager::createCamera(String name, sf::Vector2f viewSize)
+{
+	Camera*& camera = this->cameras[name];
+	if (camera == NULL) {
+		camera = new Camera(viewSize);
+	}
+
+	return camera;
+}
+
+Camera* CameraManager::getCamera(String name)
+{
+	auto found = this->cameras.find(name);
+	if (found == this->cameras.end()) {
+		std::cout << "[CameraManager] Camera " << name << " not found!" << std::endl;
+		return NULL;
+	}
+
+	return found->second;
+}
+
+void CameraManager::bindLayer(RenderLayer layer, String cameraName)
+{
+	this->layerCameras[static_cast<int>(layer)] = this->getCamera(cameraName);
+}
+
+Camera* CameraManager::getLayerCamera(RenderLayer layer)
+{
+	return this->layerCameras[static_cast<int>(layer)];
+}
+
+void CameraManager::update(sf::Time deltaTime)
+{
+	for (auto& entry : this->cameras) {
+		entry.second->update(deltaTime);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+//singleton class
+/* Named cameras, and which camera each render layer is drawn through. Layers without a camera use the
+ * window's default view, so backgrounds and UI stay fixed while the world layer scrolls.
+ */
+#include <string>
+#include <unordered_map>
+#include "AGameObject.h"
+#include "Camera.h"
+
+class CameraManager
+{
+public:
+	typedef std::string String;
+
+	static CameraManager* getInstance();
+
+	Camera* createCamera(String name, sf::Vector2f viewSize);
+	Camera* getCamera(String name);
+	void bindLayer(RenderLayer layer, String cameraName);
+	Camera* getLayerCamera(RenderLayer layer); //NULL for layers drawn through the default view
+
+	void update(sf::Time deltaTime);
+
+private:
+	CameraManager() {};
+	CameraManager(CameraManager const&) {};             // copy constructor is private
+	CameraManager& operator=(CameraManager const&) = delete;  // assignment operator is deleted
+	static CameraManager* sharedInstance;
+
+	std::unordered_map<String, Camera*> cameras;
+	Camera* layerCameras[RENDER_LAYER_COUNT] = {};
+};
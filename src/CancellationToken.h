@@ -0,0 +1,17 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// Shared flag handed to queued tasks. Cancelling does not interrupt a running task;
+// tasks check it before starting expensive work and bail out early.
+class CancellationToken {
+public:
+    CancellationToken() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void Cancel() { cancelled->store(true, std::memory_order_release); }
+    bool IsCancelled() const { return cancelled->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+};
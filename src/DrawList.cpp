@@ -0,0 +1,59 @@
+#include "DrawList.h"
+
+void DrawList::clear()
+{
+	this->commands.clear();
+	this->vertices.clear();
+	this->views.clear();
+	this->customCommands.clear();
+}
+
+void DrawList::setView(const sf::View& view)
+{
+	this->commands.push_back(Command{ CommandType::View, this->views.size(), 0, nullptr });
+	this->views.push_back(view);
+}
+
+void DrawList::addVertices(const sf::Vertex* vertices, size_t count, const sf::Texture* texture)
+{
+	//consecutive ranges with the same texture become one draw call
+	if (!this->commands.empty()) {
+		Command& last = this->commands.back();
+		if (last.type == CommandType::Vertices && last.texture == texture && last.index + last.count == this->vertices.size()) {
+			this->vertices.insert(this->vertices.end(), vertices, vertices + count);
+			last.count += count;
+			return;
+		}
+	}
+
+	this->commands.push_back(Command{ CommandType::Vertices, this->vertices.size(), count, texture });
+	this->vertices.insert(this->vertices.end(), vertices, vertices + count);
+}
+
+void DrawList::addCustom(CustomCommand command)
+{
+	this->commands.push_back(Command{ CommandType::Custom, this->customCommands.size(), 0, nullptr });
+	this->customCommands.push_back(std::move(command));
+}
+
+void DrawList::execute(sf::RenderTarget& target) const
+{
+	for (const Command& command : this->commands) {
+		switch (command.type) {
+		case CommandType::View:
+			target.setView(this->views[command.index]);
+			break;
+		case CommandType::Vertices:
+			target.draw(&this->vertices[command.index], command.count, sf::Triangles, sf::RenderStates(command.texture));
+			break;
+		case CommandType::Custom:
+			this->customCommands[command.index](target);
+			break;
+		}
+	}
+}
+
+size_t DrawList::getCommandCount() const
+{
+	return this->commands.size();
+}
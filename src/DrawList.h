@@ -0,0 +1,43 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/* Everything needed to draw one frame, recorded by the update thread and replayed by the render thread.
+ * Once submitted it is never modified, so the two threads share nothing but the textures it points to.
+ * Custom commands must capture what they draw by value.
+ */
+class DrawList : sf::NonCopyable
+{
+public:
+	typedef std::function<void(sf::RenderTarget&)> CustomCommand;
+
+	void clear();
+	void setView(const sf::View& view);
+	void addVertices(const sf::Vertex* vertices, size_t count, const sf::Texture* texture); //triangles
+	void addCustom(CustomCommand command);
+
+	void execute(sf::RenderTarget& target) const;
+	size_t getCommandCount() const;
+
+private:
+	enum class CommandType
+	{
+		View,
+		Vertices,
+		Custom
+	};
+
+	struct Command
+	{
+		CommandType type;
+		size_t index; //into views or customCommands, or the first vertex
+		size_t count;
+		const sf::Texture* texture;
+	};
+
+	std::vector<Command> commands;
+	std::vector<sf::Vertex> vertices;
+	std::vector<sf::View> views;
+	std::vector<CustomCommand> customCommands;
+};
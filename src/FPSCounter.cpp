@@ -1,9 +1,12 @@
 #include "FPSCounter.h"
 #include <iostream>
 #include "BaseRunner.h"
+#include "DrawList.h"
+#include "GameObjectManager.h"
 
 FPSCounter::FPSCounter() : AGameObject("FPSCounter")
 {
+	this->setRenderLayer(RenderLayer::UI);
 }
 
 FPSCounter::~FPSCounter()
@@ -33,7 +36,7 @@ void FPSCounter::initialize()
 
 	this->statsText = new sf::Text();
 	this->statsText->setFont(*this->font);
-	this->statsText->setPosition(BaseRunner::WINDOW_WIDTH - 150, BaseRunner::WINDOW_HEIGHT - 70);
+	this->statsText->setPosition(BaseRunner::WINDOW_WIDTH - 330, BaseRunner::WINDOW_HEIGHT - 150);
 	this->statsText->setOutlineColor(sf::Color::White);  // Better syntax
 	this->statsText->setOutlineThickness(2.5f);
 	this->statsText->setCharacterSize(35);
@@ -57,6 +60,23 @@ void FPSCounter::draw(sf::RenderWindow* targetWindow)
 		targetWindow->draw(*this->statsText);
 }
 
+void FPSCounter::record(DrawList* list)
+{
+	AGameObject::record(list);
+
+	if (this->statsText != nullptr)
+	{
+		sf::Text text = *this->statsText;
+		list->addCustom([text](sf::RenderTarget& target) { target.draw(text); });
+	}
+}
+
+//sf::Text cannot go through the sprite batch
+bool FPSCounter::isBatchable()
+{
+	return false;
+}
+
 void FPSCounter::updateFPS(sf::Time elapsedTime)
 {
 	this->updateTime += elapsedTime;
@@ -66,7 +86,13 @@ void FPSCounter::updateFPS(sf::Time elapsedTime)
 	{
 		float fps = this->framesPassed / this->updateTime.asSeconds();
 
-		this->statsText->setString("FPS: " + std::to_string((int)fps));
+		//both counters are reset when a frame starts drawing, so they hold the last full frame
+		int drawn = GameObjectManager::getInstance()->getDrawnObjectCount();
+		int transforms = AGameObject::getTransformUpdateCount();
+
+		this->statsText->setString("FPS: " + std::to_string((int)fps) +
+			"\nDrawn: " + std::to_string(drawn) +
+			"\nTransforms: " + std::to_string(transforms));
 
 		this->updateTime = sf::Time::Zero;
 		this->framesPassed = 0;
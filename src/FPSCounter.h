@@ -11,6 +11,8 @@ public:
 	void processInput(sf::Event event) override;
 	void update(sf::Time deltaTime) override;
 	void draw(sf::RenderWindow* targetWindow) override;
+	bool isBatchable() override;
+	void record(DrawList* list) override;
 
 private:
 	sf::Time updateTime;
@@ -0,0 +1,84 @@
+#include "FramePacer.h"
+#include <thread>
+
+FramePacer::FramePacer(sf::Time timeStep, int maxStepsPerFrame)
+{
+	this->timeStep = timeStep;
+	this->maxStepsPerFrame = maxStepsPerFrame;
+}
+
+void FramePacer::beginFrame()
+{
+	this->accumulator += this->frameClock.restart();
+	this->stepsThisFrame = 0;
+
+	sf::Time maxBacklog = this->timeStep * static_cast<float>(this->maxStepsPerFrame);
+	if (this->accumulator > maxBacklog) {
+		this->droppedTime += this->accumulator - maxBacklog;
+		this->accumulator = maxBacklog;
+		this->clampedFrameCount++;
+	}
+}
+
+bool FramePacer::consumeStep()
+{
+	if (this->accumulator < this->timeStep || this->stepsThisFrame >= this->maxStepsPerFrame) {
+		return false;
+	}
+
+	this->accumulator -= this->timeStep;
+	this->stepsThisFrame++;
+	return true;
+}
+
+float FramePacer::getInterpolationAlpha() const
+{
+	float alpha = this->accumulator / this->timeStep;
+	return alpha < 1.0f ? alpha : 1.0f;
+}
+
+void FramePacer::endFrame()
+{
+	if (this->limitMode != LimitMode::Sleep) {
+		return;
+	}
+
+	this->nextFrameDeadline += this->frameDuration;
+
+	//too far behind to catch up, start counting from now instead of rushing the next frames
+	sf::Time now = this->limiterClock.getElapsedTime();
+	if (now > this->nextFrameDeadline + this->frameDuration) {
+		this->nextFrameDeadline = now;
+		return;
+	}
+
+	sf::Time remaining = this->nextFrameDeadline - now;
+	if (remaining > SPIN_MARGIN) {
+		sf::sleep(remaining - SPIN_MARGIN);
+	}
+	while (this->limiterClock.getElapsedTime() < this->nextFrameDeadline) {
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::setLimit(LimitMode mode, unsigned int framesPerSecond)
+{
+	this->limitMode = mode;
+	this->frameDuration = framesPerSecond > 0 ? sf::seconds(1.0f / framesPerSecond) : sf::Time::Zero;
+	this->nextFrameDeadline = this->limiterClock.getElapsedTime();
+}
+
+FramePacer::LimitMode FramePacer::getLimitMode() const
+{
+	return this->limitMode;
+}
+
+int FramePacer::getClampedFrameCount() const
+{
+	return this->clampedFrameCount;
+}
+
+sf::Time FramePacer::getDroppedTime() const
+{
+	return this->droppedTime;
+}
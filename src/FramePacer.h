@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/System.hpp>
+
+/* Fixed-step frame timing. Each frame adds the measured time to a backlog that is paid off in fixed steps,
+ * at most maxStepsPerFrame of them, so one long stall cannot snowball into ever longer catch-up frames.
+ * Whatever is left over becomes the interpolation alpha for rendering. Optionally sleeps the rest of each
+ * frame away, spinning for the last stretch because sleeps overshoot.
+ */
+class FramePacer
+{
+public:
+	enum class LimitMode
+	{
+		None,
+		VSync, //the window blocks in display(); nothing to do here
+		Sleep
+	};
+
+	FramePacer(sf::Time timeStep, int maxStepsPerFrame = 5);
+
+	void beginFrame();
+	bool consumeStep(); //true while another fixed step is due this frame
+	float getInterpolationAlpha() const; //0 = state of the previous step, 1 = state of the latest one
+	void endFrame(); //waits for the frame deadline in Sleep mode
+
+	void setLimit(LimitMode mode, unsigned int framesPerSecond = 60);
+	LimitMode getLimitMode() const;
+
+	int getClampedFrameCount() const; //frames whose backlog was cut to maxStepsPerFrame
+	sf::Time getDroppedTime() const; //simulation time thrown away by those cuts
+
+private:
+	const sf::Time SPIN_MARGIN = sf::milliseconds(2);
+
+	sf::Time timeStep;
+	int maxStepsPerFrame;
+
+	sf::Clock frameClock;
+	sf::Time accumulator = sf::Time::Zero;
+	int stepsThisFrame = 0;
+
+	LimitMode limitMode = LimitMode::None;
+	sf::Time frameDuration = sf::Time::Zero;
+	sf::Clock limiterClock;
+	sf::Time nextFrameDeadline = sf::Time::Zero;
+
+	int clampedFrameCount = 0;
+	sf::Time droppedTime = sf::Time::Zero;
+};
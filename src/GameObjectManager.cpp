@@ -1,9 +1,21 @@
 #include <stddef.h>
 #include "GameObjectManager.h"
+#include "CameraManager.h"
+#include "ThreadPool.h"
 #include <iostream>
+#include <algorithm>
 
 GameObjectManager* GameObjectManager::sharedInstance = NULL;
 
+GameObjectManager::GameObjectManager()
+{
+}
+
+GameObjectManager::~GameObjectManager()
+{
+	this->shutdown();
+}
+
 GameObjectManager* GameObjectManager::getInstance() {
 	if (sharedInstance == NULL) {
 		//initialize
@@ -15,8 +27,9 @@ GameObjectManager* GameObjectManager::getInstance() {
 
 AGameObject* GameObjectManager::findObjectByName(AGameObject::String name)
 {
-	if (this->gameObjectMap[name] != NULL) {
-		return this->gameObjectMap[name];
+	auto found = this->nameIndex.find(name);
+	if (found != this->nameIndex.end()) {
+		return this->getObject(found->second);
 	}
 	else {
 		std::cout << "Object " << name << " not found!";
@@ -24,6 +37,16 @@ AGameObject* GameObjectManager::findObjectByName(AGameObject::String name)
 	}
 }
 
+AGameObject* GameObjectManager::getObject(ObjectHandle handle)
+{
+	if (handle.index >= this->objectSlots.size()) {
+		return NULL;
+	}
+
+	const ObjectSlot& slot = this->objectSlots[handle.index];
+	return slot.generation == handle.generation ? slot.object : NULL;
+}
+
 List GameObjectManager::getAllObjects()
 {
 	return this->gameObjectList;
@@ -35,54 +58,375 @@ int GameObjectManager::activeObjects()
 }
 
 void GameObjectManager::processInput(sf::Event event) {
+	this->iteratingObjects = true;
 	for (int i = 0; i < this->gameObjectList.size(); i++) {
 		this->gameObjectList[i]->processInput(event);
 	}
+	this->iteratingObjects = false;
 }
 
 void GameObjectManager::update(sf::Time deltaTime)
 {
+	//the list cannot change under the loop, objects added or deleted by an update wait for the end of the step
+	this->applyPendingChanges();
+
 	//std::cout << "Delta time: " << deltaTime.asSeconds() << "\n";
-	for (int i = 0; i < this->gameObjectList.size(); i++) {
-		this->gameObjectList[i]->update(deltaTime);
+	this->iteratingObjects = true;
+	this->updateInParallel(deltaTime);
+	this->iteratingObjects = false;
+
+	this->applyPendingChanges();
+}
+
+void GameObjectManager::updateInParallel(sf::Time deltaTime)
+{
+	//removal reorders gameObjectList, the update order must not depend on which objects were removed
+	if (this->updateListDirty) {
+		this->updateList = this->gameObjectList;
+		std::sort(this->updateList.begin(), this->updateList.end(), [](AGameObject* a, AGameObject* b) {
+			return a->getAddOrder() < b->getAddOrder();
+		});
+		this->updateListDirty = false;
+	}
+
+	this->serialUpdates.clear();
+	this->parallelUpdates.clear();
+	this->groupedUpdates.clear();
+	for (AGameObject* object : this->updateList) {
+		if (object->getUpdateGroup() != 0) {
+			this->groupedUpdates.push_back(object);
+		}
+		else if (object->isThreadSafeUpdate()) {
+			this->parallelUpdates.push_back(object);
+		}
+		else {
+			this->serialUpdates.push_back(object);
+		}
+	}
+
+	auto updateRange = [deltaTime](AGameObject* const* objects, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			objects[i]->beginFixedStep();
+			objects[i]->update(deltaTime);
+		}
+	};
+
+	//handing a few objects to the pool costs more than updating them here. the passes run in the same sequence
+	//either way, so what an object can rely on about the order does not depend on the object count
+	this->parallelUpdateCount = static_cast<int>(this->parallelUpdates.size() + this->groupedUpdates.size());
+	if (this->parallelUpdateCount == 0 || this->parallelUpdateCount < this->parallelUpdateThreshold) {
+		this->parallelUpdateCount = 0;
+		updateRange(this->parallelUpdates.data(), this->parallelUpdates.size());
+		updateRange(this->groupedUpdates.data(), this->groupedUpdates.size());
+		updateRange(this->serialUpdates.data(), this->serialUpdates.size());
+		return;
+	}
+
+	if (!this->updatePool) {
+		//the main thread works too, so one core is left for it
+		unsigned int coreCount = std::thread::hardware_concurrency();
+		unsigned int workerCount = coreCount > 1 ? coreCount - 1 : 1;
+		this->updatePool = std::make_unique<ThreadPool>(static_cast<int>(workerCount), ThreadPool::SchedulingMode::WorkStealing);
+		this->updatePool->StartScheduling();
 	}
+
+	//independent objects go out in fixed-size chunks, each group as one piece so its objects stay in order
+	std::vector<std::pair<AGameObject* const*, size_t>>& ranges = this->updateRanges;
+	ranges.clear();
+	for (size_t first = 0; first < this->parallelUpdates.size(); first += PARALLEL_UPDATE_CHUNK_SIZE) {
+		ranges.emplace_back(this->parallelUpdates.data() + first, std::min<size_t>(PARALLEL_UPDATE_CHUNK_SIZE, this->parallelUpdates.size() - first));
+	}
+
+	std::stable_sort(this->groupedUpdates.begin(), this->groupedUpdates.end(), [](AGameObject* a, AGameObject* b) {
+		return a->getUpdateGroup() < b->getUpdateGroup();
+	});
+	for (size_t first = 0; first < this->groupedUpdates.size();) {
+		size_t last = first + 1;
+		while (last < this->groupedUpdates.size() && this->groupedUpdates[last]->getUpdateGroup() == this->groupedUpdates[first]->getUpdateGroup()) {
+			last++;
+		}
+		ranges.emplace_back(this->groupedUpdates.data() + first, last - first);
+		first = last;
+	}
+
+	//the main thread takes the last piece itself instead of idling in the join. the pieces carry no future,
+	//a counter that lives as long as the manager is enough to wait for them
+	std::atomic<size_t>* remaining = &this->pendingUpdateRanges;
+	remaining->store(ranges.size() - 1, std::memory_order_relaxed);
+	for (size_t i = 0; i + 1 < ranges.size(); i++) {
+		auto range = ranges[i];
+		this->updatePool->ScheduleDetached([updateRange, range, remaining] {
+			updateRange(range.first, range.second);
+			if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				remaining->notify_one();
+			}
+		});
+	}
+	updateRange(ranges.back().first, ranges.back().second);
+	for (size_t left = remaining->load(std::memory_order_acquire); left != 0; left = remaining->load(std::memory_order_acquire)) {
+		remaining->wait(left, std::memory_order_acquire);
+	}
+
+	updateRange(this->serialUpdates.data(), this->serialUpdates.size());
 }
 
-//draws the object if it contains a sprite
-void GameObjectManager::draw(sf::RenderWindow* window) {
-	for (int i = 0; i < this->gameObjectList.size(); i++) {
-		this->gameObjectList[i]->draw(window);
+void GameObjectManager::draw(sf::RenderWindow* window, float interpolationAlpha) {
+	DrawTarget target;
+	target.setView = [window](const sf::View& view) { window->setView(view); };
+	target.flushBatch = [this, window](float opacity) { this->spriteBatch.flush(*window, opacity); };
+	target.drawUnbatched = [window](AGameObject* object) { object->draw(window); };
+
+	this->iteratingObjects = true;
+	this->drawLayers(window->getDefaultView(), interpolationAlpha, target);
+	this->iteratingObjects = false;
+	window->setView(window->getDefaultView());
+}
+
+void GameObjectManager::recordDrawList(DrawList* list, const sf::View& defaultView, float interpolationAlpha)
+{
+	DrawTarget target;
+	target.setView = [list](const sf::View& view) { list->setView(view); };
+	target.flushBatch = [this, list](float opacity) { this->spriteBatch.flush(*list, opacity); };
+	target.drawUnbatched = [list](AGameObject* object) { object->record(list); };
+
+	this->iteratingObjects = true;
+	this->drawLayers(defaultView, interpolationAlpha, target);
+	this->iteratingObjects = false;
+	list->setView(defaultView);
+}
+
+SpriteBatch* GameObjectManager::getSpriteBatch()
+{
+	return &this->spriteBatch;
+}
+
+int GameObjectManager::getParallelUpdateCount()
+{
+	return this->parallelUpdateCount;
+}
+
+void GameObjectManager::setParallelUpdateThreshold(int threshold)
+{
+	this->parallelUpdateThreshold = threshold;
+}
+
+int GameObjectManager::getParallelUpdateThreshold()
+{
+	return this->parallelUpdateThreshold;
+}
+
+int GameObjectManager::getDrawnObjectCount()
+{
+	return this->drawnObjectCount;
+}
+
+sf::FloatRect GameObjectManager::getVisibleArea()
+{
+	return this->visibleArea;
+}
+
+void GameObjectManager::setLayerOpacity(RenderLayer layer, float opacity)
+{
+	this->layerOpacity[static_cast<int>(layer)] = std::clamp(opacity, 0.0f, 1.0f);
+}
+
+float GameObjectManager::getLayerOpacity(RenderLayer layer)
+{
+	return this->layerOpacity[static_cast<int>(layer)];
+}
+
+//batchable objects only submit quads; anything else flushes the batch first so the draw order is kept
+void GameObjectManager::drawLayers(const sf::View& defaultView, float interpolationAlpha, const DrawTarget& target)
+{
+	this->sortDrawList();
+	AGameObject::setInterpolationAlpha(interpolationAlpha);
+
+	this->drawnObjectCount = 0;
+	AGameObject::resetTransformUpdateCount();
+
+	this->spriteBatch.begin();
+	size_t layerStart = 0;
+	while (layerStart < this->drawList.size()) {
+		RenderLayer layer = this->drawList[layerStart]->getRenderLayer();
+		size_t layerEnd = layerStart;
+		while (layerEnd < this->drawList.size() && this->drawList[layerEnd]->getRenderLayer() == layer) {
+			layerEnd++;
+		}
+
+		//each layer is drawn through its own camera
+		Camera* camera = CameraManager::getInstance()->getLayerCamera(layer);
+		sf::View view = camera != NULL ? camera->getInterpolatedView(interpolationAlpha) : defaultView;
+		target.setView(view);
+
+		//world-space rectangle seen through the view, rotation included. objects with many parts cull against it
+		this->visibleArea = view.getInverseTransform().transformRect(sf::FloatRect(-1.0f, -1.0f, 2.0f, 2.0f));
+
+		for (size_t i = layerStart; i < layerEnd; i++) {
+			AGameObject* object = this->drawList[i];
+			this->drawnObjectCount++;
+			if (object->isBatchable()) {
+				object->submit(&this->spriteBatch);
+			}
+			else {
+				target.flushBatch(this->getLayerOpacity(layer));
+				target.drawUnbatched(object);
+			}
+		}
+		target.flushBatch(this->getLayerOpacity(layer));
+		layerStart = layerEnd;
+	}
+}
+
+void GameObjectManager::sortDrawList()
+{
+	if (this->drawListDirty) {
+		this->drawList = this->gameObjectList;
+		this->drawListDirty = false;
+	}
+
+	//layers can change at any time, objects of the same layer keep the order they were added in
+	auto byLayer = [](AGameObject* a, AGameObject* b) {
+		if (a->getRenderLayer() != b->getRenderLayer()) {
+			return a->getRenderLayer() < b->getRenderLayer();
+		}
+		return a->getAddOrder() < b->getAddOrder();
+	};
+	if (!std::is_sorted(this->drawList.begin(), this->drawList.end(), byLayer)) {
+		std::sort(this->drawList.begin(), this->drawList.end(), byLayer);
 	}
 }
 
 void GameObjectManager::addObject(AGameObject* gameObject)
 {
-	//also initialize the oject
-	this->gameObjectMap[gameObject->getName()] = gameObject;
-	this->gameObjectList.push_back(gameObject);
-	this->gameObjectMap[gameObject->getName()]->initialize();
+	std::lock_guard<std::mutex> lock(this->pendingMutex);
+
+	//a new object may get the address of one removed earlier in the same pass
+	this->pendingRemovals.erase(gameObject);
+	this->pendingChanges.push_back(PendingChange{ gameObject, false });
 }
 
-//also frees up allocation of the object.
 void GameObjectManager::deleteObject(AGameObject* gameObject)
 {
-	this->gameObjectMap.erase(gameObject->getName());
+	std::lock_guard<std::mutex> lock(this->pendingMutex);
 
-	int index = -1;
-	for (int i = 0; i < this->gameObjectList.size(); i++) {
-		if (this->gameObjectList[i] == gameObject) {
-			index = i;
-			break;
+	//deleting twice is harmless, also from a destructor after the first delete was already applied in this pass
+	if (!this->pendingRemovals.insert(gameObject).second) {
+		return;
+	}
+	this->pendingChanges.push_back(PendingChange{ gameObject, true });
+}
+
+void GameObjectManager::applyPendingChanges()
+{
+	//removal swaps the last object into the freed place, which would skip or repeat objects in a running loop.
+	//called from inside one, the changes simply wait for the next frame boundary
+	if (this->iteratingObjects) {
+		return;
+	}
+
+	//initialize and destructors may queue more changes, those are applied in the same pass
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(this->pendingMutex);
+			if (this->pendingChanges.empty()) {
+				this->pendingRemovals.clear();
+				return;
+			}
+			this->applyingChanges.swap(this->pendingChanges);
+		}
+
+		for (const PendingChange& change : this->applyingChanges) {
+			if (change.remove) {
+				this->removeObject(change.object);
+			}
+			else {
+				this->insertObject(change.object);
+			}
 		}
+		this->applyingChanges.clear();
 	}
+}
 
-	if (index != -1) {
-		this->gameObjectList.erase(this->gameObjectList.begin() + index);
+void GameObjectManager::shutdown()
+{
+	//the pool joins its workers when it goes away
+	if (this->updatePool) {
+		this->updatePool->StopScheduling();
+		this->updatePool.reset();
 	}
-	
+}
+
+void GameObjectManager::insertObject(AGameObject* gameObject)
+{
+	ObjectHandle handle;
+	if (this->firstFreeSlot != ObjectHandle::INVALID_INDEX) {
+		handle.index = this->firstFreeSlot;
+		this->firstFreeSlot = this->objectSlots[handle.index].nextFree;
+	}
+	else {
+		handle.index = static_cast<std::uint32_t>(this->objectSlots.size());
+		this->objectSlots.push_back(ObjectSlot());
+	}
+
+	ObjectSlot& slot = this->objectSlots[handle.index];
+	handle.generation = slot.generation;
+	slot.object = gameObject;
+	slot.listIndex = static_cast<int>(this->gameObjectList.size());
+
+	gameObject->setHandle(handle, this->nextAddOrder++);
+	if (gameObject->isNameIndexed()) {
+		this->nameIndex[gameObject->getName()] = handle;
+	}
+
+	//also initialize the oject
+	this->gameObjectList.push_back(gameObject);
+	this->drawListDirty = true;
+	this->updateListDirty = true;
+	gameObject->initialize();
+}
+
+//also frees up allocation of the object.
+void GameObjectManager::removeObject(AGameObject* gameObject)
+{
+	ObjectHandle handle = gameObject->getHandle();
+	if (this->getObject(handle) != gameObject) {
+		std::cout << "[GameObjectManager] " << gameObject->getName() << " is not a managed object" << std::endl;
+		return;
+	}
+
+	//a later object may have taken the name over
+	auto named = this->nameIndex.find(gameObject->getName());
+	if (named != this->nameIndex.end() && named->second == handle) {
+		this->nameIndex.erase(named);
+	}
+
+	//the list order does not matter, draw order comes from sortDrawList
+	ObjectSlot& slot = this->objectSlots[handle.index];
+	AGameObject* last = this->gameObjectList.back();
+	this->gameObjectList[slot.listIndex] = last;
+	this->objectSlots[last->getHandle().index].listIndex = slot.listIndex;
+	this->gameObjectList.pop_back();
+	this->drawListDirty = true;
+	this->updateListDirty = true;
+
+	slot.object = NULL;
+	slot.listIndex = -1;
+	slot.generation++;
+	slot.nextFree = this->firstFreeSlot;
+	this->firstFreeSlot = handle.index;
+
 	delete gameObject;
 }
 
+void GameObjectManager::deleteObject(ObjectHandle handle)
+{
+	AGameObject* object = this->getObject(handle);
+
+	if (object != NULL) {
+		this->deleteObject(object);
+	}
+}
+
 void GameObjectManager::deleteObjectByName(AGameObject::String name) {
 	AGameObject* object = this->findObjectByName(name);
 	
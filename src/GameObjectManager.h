@@ -3,35 +3,136 @@
 /* Game object manager contains all of the declared game object classes and calls the update function
  */
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
 #include "AGameObject.h"
+#include "SpriteBatch.h"
+#include "DrawList.h"
 #include <SFML/Graphics.hpp>
 
-typedef std::unordered_map<std::string, AGameObject*> HashTable;
+typedef std::unordered_map<std::string, ObjectHandle> NameIndex;
 typedef std::vector<AGameObject*> List;
 
+class ThreadPool;
+
 class GameObjectManager
 {
 	public:
 		static GameObjectManager* getInstance();
-		AGameObject* findObjectByName(AGameObject::String name);
+		AGameObject* findObjectByName(AGameObject::String name); //only finds objects that opted into the name index
+		AGameObject* getObject(ObjectHandle handle); //NULL once the object was deleted
 		List getAllObjects();
 		int activeObjects();
 		void processInput(sf::Event event);
 		void update(sf::Time deltaTime);
-		void draw(sf::RenderWindow* window);
+		void draw(sf::RenderWindow* window, float interpolationAlpha = 1.0f); //alpha: how far between the last two fixed steps to draw
+		void recordDrawList(DrawList* list, const sf::View& defaultView, float interpolationAlpha = 1.0f); //same frame as draw, for the render thread
+
+		//adding and deleting only queue the change, it happens in applyPendingChanges at the next frame boundary.
+		//any thread may queue; an added object is initialized and gets its handle when the change is applied.
 		void addObject(AGameObject* gameObject);
 		void deleteObject(AGameObject* gameObject);
+		void deleteObject(ObjectHandle handle);
 		void deleteObjectByName(AGameObject::String name);
+		void applyPendingChanges(); //main thread, outside of update and draw
+		void shutdown(); //stops the update workers, once the main loop is done
+
+		//new + addObject in one call, the manager owns the object from here on
+		template <typename T, typename... Args>
+		T* createObject(Args&&... args)
+		{
+			T* gameObject = new T(std::forward<Args>(args)...);
+			this->addObject(gameObject);
+			return gameObject;
+		}
+		SpriteBatch* getSpriteBatch();
+		int getParallelUpdateCount(); //objects updated on worker threads in the last step
+		void setParallelUpdateThreshold(int threshold); //opted-in objects needed before the pool is used, 0 = always
+		int getParallelUpdateThreshold();
+		int getDrawnObjectCount(); //per frame
+		sf::FloatRect getVisibleArea(); //world rectangle of the layer being drawn, for objects that cull their own contents
+
+		//group opacity for every batched object in a layer, applied once per flush instead of per sprite
+		void setLayerOpacity(RenderLayer layer, float opacity);
+		float getLayerOpacity(RenderLayer layer);
 
 	private:
-		GameObjectManager() {};
-		GameObjectManager(GameObjectManager const&) {};             // copy constructor is private
-		GameObjectManager& operator=(GameObjectManager const&) {};  // assignment operator is private
+		GameObjectManager(); //defined where ThreadPool is complete, for the update pool
+		~GameObjectManager();
+		GameObjectManager(GameObjectManager const&) = delete;             // copy constructor is deleted
+		GameObjectManager& operator=(GameObjectManager const&) = delete;  // assignment operator is deleted
 		static GameObjectManager* sharedInstance;
 
-		HashTable gameObjectMap;
-		List gameObjectList;
+		//slot map behind the handles. free slots are chained through nextFree
+		struct ObjectSlot
+		{
+			AGameObject* object = NULL;
+			std::uint32_t generation = 0;
+			int listIndex = -1; //position in gameObjectList
+			std::uint32_t nextFree = ObjectHandle::INVALID_INDEX;
+		};
+		std::vector<ObjectSlot> objectSlots;
+		std::uint32_t firstFreeSlot = ObjectHandle::INVALID_INDEX;
+		unsigned int nextAddOrder = 0;
+
+		struct PendingChange
+		{
+			AGameObject* object;
+			bool remove;
+		};
+		std::mutex pendingMutex;
+		std::vector<PendingChange> pendingChanges;
+		std::vector<PendingChange> applyingChanges;
+		std::unordered_set<AGameObject*> pendingRemovals; //queued or applied this pass, cleared once a pass is done
+		bool iteratingObjects = false; //set while processInput, update or draw walk the object lists
+
+		NameIndex nameIndex;
+		List gameObjectList; //unordered, removal swaps the last object in
+
+		SpriteBatch spriteBatch;
+		List drawList; //gameObjectList ordered by render layer, then by the order objects were added
+		bool drawListDirty = true;
+
+		int drawnObjectCount = 0;
+		sf::FloatRect visibleArea;
+		float layerOpacity[RENDER_LAYER_COUNT] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		//thread-safe and grouped objects are updated first, on the pool when there are enough of them, then the rest
+		//in the order they were added. see AGameObject::setThreadSafeUpdate for what each path guarantees.
+		//the threshold sweep of --bench-update puts the pool's cost at a few microseconds per step plus about one
+		//per chunk; below 512 objects with light updates that is more than other cores can save. the main thread
+		//keeps one chunk itself, so below PARALLEL_UPDATE_CHUNK_SIZE the pool would not get any work anyway
+		static const int PARALLEL_UPDATE_THRESHOLD = 512;
+		static const int PARALLEL_UPDATE_CHUNK_SIZE = 128;
+		int parallelUpdateThreshold = PARALLEL_UPDATE_THRESHOLD;
+		std::unique_ptr<ThreadPool> updatePool; //started on first use, stopped by shutdown
+		List updateList; //gameObjectList in the order objects were added
+		bool updateListDirty = true;
+		List serialUpdates;
+		List parallelUpdates;
+		List groupedUpdates;
+		std::vector<std::pair<AGameObject* const*, size_t>> updateRanges; //kept between steps so its storage is reused
+		std::atomic<size_t> pendingUpdateRanges{ 0 };
+		int parallelUpdateCount = 0;
+
+		void sortDrawList();
+		void updateInParallel(sf::Time deltaTime);
+		void insertObject(AGameObject* gameObject);
+		void removeObject(AGameObject* gameObject);
+
+		//what draw and recordDrawList do differently: where views, batches and unbatched objects go
+		struct DrawTarget
+		{
+			std::function<void(const sf::View&)> setView;
+			std::function<void(float)> flushBatch;
+			std::function<void(AGameObject*)> drawUnbatched;
+		};
+		void drawLayers(const sf::View& defaultView, float interpolationAlpha, const DrawTarget& target);
 };
 
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "PoolTask.h"
+
+class TaskSlab;
+
+// Somewhere a continuation can run: a ThreadPool worker, the main thread, ...
+class ITaskExecutor {
+public:
+    virtual ~ITaskExecutor() {}
+    virtual void Execute(PoolTask&& _task) = 0;
+    virtual TaskSlab* GetTaskSlab() { return nullptr; } // where large continuation captures should live
+};
@@ -2,6 +2,7 @@
 
 class IWorkerAction {
 public:
+	virtual ~IWorkerAction() {} // tasks are deleted through this interface after they run
 	virtual void OnStartTask() = 0;
 
-};
\ No newline at end of file
+};
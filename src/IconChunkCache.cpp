@@ -0,0 +1,219 @@
+#include "IconChunkCache.h"
+#include "GameObjectManager.h"
+#include "DrawList.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+namespace
+{
+	//tiles already hold colour multiplied by alpha, blending them with BlendAlpha would darken every soft edge
+	const sf::BlendMode PREMULTIPLIED_ALPHA(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+}
+
+IconChunkCache::IconChunkCache(String name, sf::Vector2f gridOrigin, float iconSpacing, sf::Vector2u iconSize, int columns, int rowsPerChunk) : AGameObject(name)
+{
+	this->gridOrigin = gridOrigin;
+	this->iconSpacing = iconSpacing;
+	this->iconSize = iconSize;
+	this->columns = columns;
+	this->rowsPerChunk = rowsPerChunk;
+}
+
+void IconChunkCache::initialize()
+{
+}
+
+void IconChunkCache::processInput(sf::Event event)
+{
+}
+
+void IconChunkCache::update(sf::Time deltaTime)
+{
+}
+
+void IconChunkCache::draw(sf::RenderWindow* targetWindow)
+{
+	if (!this->prepareVisibleChunks()) {
+		return;
+	}
+
+	sf::Color color = this->getOpacityColor();
+	for (int chunkIndex : this->visibleChunks) {
+		const Chunk& chunk = this->chunks[chunkIndex];
+
+		sf::Vertex quad[VERTICES_PER_QUAD];
+		this->buildChunkQuad(chunk, color, quad);
+
+		sf::RenderStates states(PREMULTIPLIED_ALPHA);
+		states.texture = &chunk.texture->getTexture();
+		targetWindow->draw(quad, VERTICES_PER_QUAD, sf::Triangles, states);
+	}
+}
+
+bool IconChunkCache::isBatchable()
+{
+	//the batch only knows straight alpha
+	return false;
+}
+
+void IconChunkCache::record(DrawList* list)
+{
+	//tiles are baked here, on the main thread; the render thread only samples them
+	if (!this->prepareVisibleChunks()) {
+		return;
+	}
+
+	sf::Color color = this->getOpacityColor();
+	for (int chunkIndex : this->visibleChunks) {
+		const Chunk& chunk = this->chunks[chunkIndex];
+
+		std::array<sf::Vertex, VERTICES_PER_QUAD> quad;
+		this->buildChunkQuad(chunk, color, quad.data());
+		const sf::Texture* texture = &chunk.texture->getTexture();
+
+		list->addCustom([quad, texture](sf::RenderTarget& target) {
+			sf::RenderStates states(PREMULTIPLIED_ALPHA);
+			states.texture = texture;
+			target.draw(quad.data(), VERTICES_PER_QUAD, sf::Triangles, states);
+		});
+	}
+}
+
+void IconChunkCache::setIcon(int index, const TextureAtlas::Region& region)
+{
+	if (index < 0) {
+		return;
+	}
+
+	if (index >= this->icons.size()) {
+		this->icons.resize(index + 1);
+	}
+	this->icons[index] = region;
+
+	int chunkIndex = index / this->columns / this->rowsPerChunk;
+	while (chunkIndex >= this->chunks.size()) {
+		Chunk chunk;
+		float top = this->gridOrigin.y + this->chunks.size() * this->rowsPerChunk * this->iconSpacing;
+		chunk.bounds = sf::FloatRect(this->gridOrigin.x, top,
+			(this->columns - 1) * this->iconSpacing + this->iconSize.x,
+			(this->rowsPerChunk - 1) * this->iconSpacing + this->iconSize.y);
+		this->chunks.push_back(std::move(chunk));
+	}
+	this->chunks[chunkIndex].dirty = true;
+}
+
+int IconChunkCache::getChunkCount()
+{
+	return this->chunks.size();
+}
+
+bool IconChunkCache::prepareVisibleChunks()
+{
+	this->visibleChunks.clear();
+
+	//nothing is baked while the grid is still hidden
+	if (GameObjectManager::getInstance()->getLayerOpacity(this->renderLayer) <= 0.0f) {
+		return false;
+	}
+
+	sf::FloatRect visibleArea = GameObjectManager::getInstance()->getVisibleArea();
+	for (int i = 0; i < this->chunks.size(); i++) {
+		if (!this->chunks[i].bounds.intersects(visibleArea)) {
+			continue;
+		}
+
+		if (this->chunks[i].dirty) {
+			this->bakeChunk(i);
+		}
+		if (this->chunks[i].texture != nullptr) {
+			this->visibleChunks.push_back(i);
+		}
+	}
+
+	return true;
+}
+
+void IconChunkCache::bakeChunk(int chunkIndex)
+{
+	Chunk& chunk = this->chunks[chunkIndex];
+	chunk.dirty = false;
+
+	if (chunk.texture == nullptr) {
+		chunk.texture = std::make_unique<sf::RenderTexture>();
+		if (!chunk.texture->create(static_cast<unsigned int>(chunk.bounds.width), static_cast<unsigned int>(chunk.bounds.height))) {
+			std::cout << "[IconChunkCache] Failed to create tile for chunk " << chunkIndex << std::endl;
+			chunk.texture.reset();
+			return;
+		}
+	}
+
+	//icons overlap their neighbours, so they are drawn in grid order like the individual sprites were
+	chunk.texture->clear(sf::Color::Transparent);
+
+	std::vector<sf::Vertex> vertices;
+	const sf::Texture* page = nullptr;
+	auto drawPending = [&]() {
+		if (!vertices.empty()) {
+			chunk.texture->draw(vertices.data(), vertices.size(), sf::Triangles, sf::RenderStates(page));
+			vertices.clear();
+		}
+	};
+
+	int firstIcon = chunkIndex * this->rowsPerChunk * this->columns;
+	int lastIcon = std::min(firstIcon + this->rowsPerChunk * this->columns, static_cast<int>(this->icons.size()));
+	for (int i = firstIcon; i < lastIcon; i++) {
+		const TextureAtlas::Region& icon = this->icons[i];
+		if (icon.page == nullptr) {
+			continue;
+		}
+
+		if (icon.page != page) {
+			drawPending();
+			page = icon.page;
+		}
+
+		int localIndex = i - firstIcon;
+		float left = (localIndex % this->columns) * this->iconSpacing;
+		float top = (localIndex / this->columns) * this->iconSpacing;
+		float right = left + icon.rect.width;
+		float bottom = top + icon.rect.height;
+
+		float u0 = static_cast<float>(icon.rect.left);
+		float v0 = static_cast<float>(icon.rect.top);
+		float u1 = u0 + icon.rect.width;
+		float v1 = v0 + icon.rect.height;
+
+		vertices.push_back(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(u0, v0)));
+		vertices.push_back(sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(u0, v1)));
+		vertices.push_back(sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u1, v0)));
+		vertices.push_back(sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u1, v0)));
+		vertices.push_back(sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(u0, v1)));
+		vertices.push_back(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u1, v1)));
+	}
+	drawPending();
+
+	chunk.texture->display();
+}
+
+void IconChunkCache::buildChunkQuad(const Chunk& chunk, sf::Color color, sf::Vertex* quad)
+{
+	float left = chunk.bounds.left;
+	float top = chunk.bounds.top;
+	float right = left + chunk.bounds.width;
+	float bottom = top + chunk.bounds.height;
+
+	quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(0.0f, 0.0f));
+	quad[1] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(0.0f, chunk.bounds.height));
+	quad[2] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(chunk.bounds.width, 0.0f));
+	quad[3] = quad[2];
+	quad[4] = quad[1];
+	quad[5] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(chunk.bounds.width, chunk.bounds.height));
+}
+
+sf::Color IconChunkCache::getOpacityColor()
+{
+	//premultiplied texels fade by scaling every channel
+	sf::Uint8 value = static_cast<sf::Uint8>(255.0f * GameObjectManager::getInstance()->getLayerOpacity(this->renderLayer));
+	return sf::Color(value, value, value, value);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "AGameObject.h"
+#include "TextureAtlas.h"
+
+/* Draws a static icon grid from render texture tiles instead of icon by icon. Every rowsPerChunk rows of the grid
+ * are baked into one tile the first time the tile becomes visible, and again only after setIcon changed an icon
+ * inside it. Each frame costs one quad per visible tile. Tiles hold premultiplied colour, so they are drawn with
+ * their own blend mode and take the layer opacity on all four colour channels.
+ */
+class IconChunkCache : public AGameObject
+{
+public:
+	IconChunkCache(String name, sf::Vector2f gridOrigin, float iconSpacing, sf::Vector2u iconSize, int columns, int rowsPerChunk = 4);
+
+	void initialize() override;
+	void processInput(sf::Event event) override;
+	void update(sf::Time deltaTime) override;
+	void draw(sf::RenderWindow* targetWindow) override;
+	bool isBatchable() override;
+	void record(DrawList* list) override;
+
+	void setIcon(int index, const TextureAtlas::Region& region); //row-major grid slot; an empty region leaves the slot blank
+
+	int getChunkCount();
+
+private:
+	struct Chunk
+	{
+		std::unique_ptr<sf::RenderTexture> texture; //created on the first bake
+		sf::FloatRect bounds; //world space
+		bool dirty = true;
+	};
+
+	static const int VERTICES_PER_QUAD = 6;
+
+	sf::Vector2f gridOrigin;
+	float iconSpacing;
+	sf::Vector2u iconSize;
+	int columns;
+	int rowsPerChunk;
+
+	std::vector<TextureAtlas::Region> icons;
+	std::vector<Chunk> chunks;
+	std::vector<int> visibleChunks;
+
+	bool prepareVisibleChunks(); //false when the layer is fully transparent
+	void bakeChunk(int chunkIndex);
+	void buildChunkQuad(const Chunk& chunk, sf::Color color, sf::Vertex* quad);
+	sf::Color getOpacityColor();
+};
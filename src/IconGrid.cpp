@@ -0,0 +1,90 @@
+#include "IconGrid.h"
+#include "SpriteBatch.h"
+#include "GameObjectManager.h"
+#include <algorithm>
+
+IconGrid::IconGrid(String name, sf::Vector2f gridOrigin, float iconSpacing, int columns) : AGameObject(name)
+{
+	this->gridOrigin = gridOrigin;
+	this->iconSpacing = iconSpacing;
+	this->columns = columns;
+}
+
+void IconGrid::initialize()
+{
+}
+
+void IconGrid::processInput(sf::Event event)
+{
+}
+
+void IconGrid::update(sf::Time deltaTime)
+{
+}
+
+void IconGrid::submit(SpriteBatch* batch)
+{
+	//only loaded icons are in the grid, blank slots are never visited
+	this->visibleIcons.clear();
+	this->loadedIcons.query(GameObjectManager::getInstance()->getVisibleArea(), this->visibleIcons);
+
+	//grid order keeps the submitted quads identical between frames while the view is still
+	std::sort(this->visibleIcons.begin(), this->visibleIcons.end());
+
+	int layer = static_cast<int>(this->renderLayer);
+	for (int i : this->visibleIcons) {
+		sf::FloatRect rect(this->positionsX[i], this->positionsY[i], this->widths[i], this->heights[i]);
+		sf::FloatRect textureRect(static_cast<float>(this->textureRects[i].left), static_cast<float>(this->textureRects[i].top),
+			static_cast<float>(this->textureRects[i].width), static_cast<float>(this->textureRects[i].height));
+		batch->submitRect(this->pages[i], rect, textureRect, sf::Color::White, layer);
+	}
+}
+
+int IconGrid::addIcon(const TextureAtlas::Region& region)
+{
+	int index = this->positionsX.size();
+	this->positionsX.push_back(this->gridOrigin.x + (index % this->columns) * this->iconSpacing);
+	this->positionsY.push_back(this->gridOrigin.y + (index / this->columns) * this->iconSpacing);
+	this->widths.push_back(0.0f);
+	this->heights.push_back(0.0f);
+	this->pages.push_back(nullptr);
+	this->textureRects.push_back(sf::IntRect());
+
+	this->setIconRegion(index, region);
+	return index;
+}
+
+void IconGrid::setIconRegion(int index, const TextureAtlas::Region& region)
+{
+	if (index < 0 || index >= this->getIconCount()) {
+		return;
+	}
+
+	this->pages[index] = region.page;
+	this->textureRects[index] = region.rect;
+	this->widths[index] = static_cast<float>(region.rect.width);
+	this->heights[index] = static_cast<float>(region.rect.height);
+
+	if (region.page != nullptr) {
+		this->loadedIcons.insert(index);
+		this->loadedIcons.markDirty(index); //the size may have changed
+	}
+	else {
+		this->loadedIcons.remove(index);
+	}
+}
+
+int IconGrid::getIconCount()
+{
+	return this->positionsX.size();
+}
+
+TextureAtlas::Region IconGrid::getIconRegion(int index)
+{
+	TextureAtlas::Region region;
+	if (index >= 0 && index < this->getIconCount()) {
+		region.page = this->pages[index];
+		region.rect = this->textureRects[index];
+	}
+	return region;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include "AGameObject.h"
+#include "TextureAtlas.h"
+#include "SpatialGrid.h"
+
+/* Every streamed icon in one object. Icons are laid out row by row from the grid origin and stored as parallel
+ * arrays, so an icon costs a few bytes instead of a game object with its own name, sprite and texture. Loaded
+ * icons are binned in a SpatialGrid, so a frame only visits the icons inside the view.
+ */
+class IconGrid : public AGameObject
+{
+public:
+	IconGrid(String name, sf::Vector2f gridOrigin, float iconSpacing, int columns);
+
+	void initialize() override;
+	void processInput(sf::Event event) override;
+	void update(sf::Time deltaTime) override;
+	void submit(SpriteBatch* batch) override;
+
+	int addIcon(const TextureAtlas::Region& region); //takes the next grid slot; an empty region reserves a blank slot
+	void setIconRegion(int index, const TextureAtlas::Region& region);
+
+	int getIconCount();
+	TextureAtlas::Region getIconRegion(int index);
+
+private:
+	sf::Vector2f gridOrigin;
+	float iconSpacing;
+	int columns;
+
+	std::vector<float> positionsX;
+	std::vector<float> positionsY;
+	std::vector<float> widths;
+	std::vector<float> heights;
+	std::vector<sf::Texture*> pages;
+	std::vector<sf::IntRect> textureRects;
+
+	SpatialGrid loadedIcons = SpatialGrid([this](int index) {
+		return sf::FloatRect(this->positionsX[index], this->positionsY[index], this->widths[index], this->heights[index]);
+	});
+	std::vector<int> visibleIcons;
+};
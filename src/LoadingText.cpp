@@ -5,6 +5,9 @@
 
 LoadingText::LoadingText(String name) : AGameObject(name)
 {
+    this->setNameIndexed(true);
+    this->setThreadSafeUpdate(true); // Only advances its own animation
+    this->setRenderLayer(RenderLayer::Overlay);
 }
 
 void LoadingText::initialize()
@@ -17,9 +20,9 @@ void LoadingText::initialize()
     this->setPosition(xPosition, yPosition);
 
     // Set up sprite with first frame if available
-    if (!animationFrames.empty() && this->sprite != nullptr)
+    if (!animationFrames.empty())
     {
-        this->sprite->setTexture(*animationFrames[0]);
+        this->getSprite()->setTexture(*animationFrames[0]);
         // Optionally scale it up/down
         // this->sprite->setScale(2.0f, 2.0f);
     }
@@ -78,7 +81,7 @@ void LoadingText::updateAnimation(sf::Time deltaTime)
         // Move to next frame (loop back to start)
         currentFrame = (currentFrame + 1) % animationFrames.size();
 
-        if (this->sprite != nullptr)
+        if (this->sprite.has_value())
         {
             this->sprite->setTexture(*animationFrames[currentFrame]);
         }
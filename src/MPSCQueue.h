@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free multi-producer / single-consumer queue (Vyukov style linked list).
+// Push never blocks or spins; TryPop must only be called from one thread at a time.
+// An item whose producer is still between its two atomic steps becomes visible on a later TryPop.
+template <class T>
+class MPSCQueue {
+public:
+    MPSCQueue()
+    {
+        Node* stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    ~MPSCQueue()
+    {
+        T discarded;
+        while (TryPop(discarded)) {}
+        delete tail;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void Push(T _value)
+    {
+        Node* node = new Node();
+        node->value = std::move(_value);
+
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool TryPop(T& _value)
+    {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+
+        // next becomes the new stub once its value has been moved out
+        _value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    bool Empty() const { return tail->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        T value;
+    };
+
+    alignas(64) std::atomic<Node*> head;
+    alignas(64) Node* tail;
+};
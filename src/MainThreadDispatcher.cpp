@@ -0,0 +1,28 @@
+#include "MainThreadDispatcher.h"
+#include <mutex>
+
+MainThreadDispatcher* MainThreadDispatcher::sharedInstance = nullptr;
+static std::once_flag sharedInstanceFlag;
+
+MainThreadDispatcher* MainThreadDispatcher::getInstance()
+{
+	std::call_once(sharedInstanceFlag, [] {
+		sharedInstance = new MainThreadDispatcher();
+	});
+
+	return sharedInstance;
+}
+
+void MainThreadDispatcher::Execute(PoolTask&& task)
+{
+	this->pendingTasks.Push(std::move(task));
+}
+
+void MainThreadDispatcher::drainTasks()
+{
+	PoolTask task;
+	while (this->pendingTasks.TryPop(task)) {
+		task();
+		task.reset();
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "ITaskExecutor.h"
+#include "MPSCQueue.h"
+
+/* Executor for work that must happen on the main thread (GL calls, game object changes).
+ * Any thread can post without locking; BaseRunner drains the queue once per frame.
+ */
+class MainThreadDispatcher : public ITaskExecutor
+{
+public:
+	static MainThreadDispatcher* getInstance();
+
+	void Execute(PoolTask&& task) override;
+	void drainTasks(); //main thread only
+
+private:
+	MainThreadDispatcher() {};
+	MainThreadDispatcher(MainThreadDispatcher const&) {};
+	MainThreadDispatcher& operator=(MainThreadDispatcher const&) = delete;
+	static MainThreadDispatcher* sharedInstance;
+
+	MPSCQueue<PoolTask> pendingTasks;
+};
@@ -1 +1,24 @@
 #include "MathUtils.h"
+#include <algorithm>
+#include <cmath>
+
+float MathUtils::ease(Easing easing, float t)
+{
+	t = std::clamp(t, 0.0f, 1.0f);
+
+	switch (easing) {
+	case Easing::QuadIn:
+		return t * t;
+	case Easing::QuadOut:
+		return 1.0f - (1.0f - t) * (1.0f - t);
+	case Easing::QuadInOut:
+		return t < 0.5f ? 2.0f * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 2.0f) / 2.0f;
+	default:
+		return t;
+	}
+}
+
+float MathUtils::lerp(float from, float to, float t)
+{
+	return from + (to - from) * t;
+}
@@ -1,5 +1,16 @@
 #pragma once
 class MathUtils
 {
+public:
+	enum class Easing
+	{
+		Linear,
+		QuadIn,
+		QuadOut,
+		QuadInOut
+	};
+
+	static float ease(Easing easing, float t); //t is clamped to [0, 1]
+	static float lerp(float from, float to, float t);
 };
 
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+/* Refers to a game object by its slot in GameObjectManager. The generation changes every time the slot is reused,
+ * so a handle to a deleted object resolves to NULL instead of to whatever took its place.
+ */
+struct ObjectHandle
+{
+	static const std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+	std::uint32_t index = INVALID_INDEX;
+	std::uint32_t generation = 0;
+
+	bool isValid() const
+	{
+		return this->index != INVALID_INDEX;
+	}
+
+	bool operator==(const ObjectHandle& other) const
+	{
+		return this->index == other.index && this->generation == other.generation;
+	}
+
+	bool operator!=(const ObjectHandle& other) const
+	{
+		return !(*this == other);
+	}
+};
@@ -0,0 +1,84 @@
+#include "PixelKernelBenchmark.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "PixelKernels.h"
+
+namespace
+{
+	const unsigned int SOURCE_SIZE = 512;
+	const unsigned int TARGET_SIZE = 256;
+
+	void report(const char* label, sf::Time total, int iterations)
+	{
+		std::cout << "[PixelKernelBenchmark] " << std::left << std::setw(28) << label
+			<< std::right << std::setw(10) << std::fixed << std::setprecision(1)
+			<< (total.asMicroseconds() / static_cast<double>(iterations)) << " us/icon" << std::endl;
+	}
+}
+
+void PixelKernelBenchmark::run(int iterations)
+{
+	std::vector<PixelKernels::Byte> sourcePixels(SOURCE_SIZE * SOURCE_SIZE * 4);
+	std::mt19937 random(1234);
+	for (auto& value : sourcePixels) {
+		value = static_cast<PixelKernels::Byte>(random());
+	}
+
+	sf::Image source;
+	source.create(SOURCE_SIZE, SOURCE_SIZE, sourcePixels.data());
+
+	std::cout << "[PixelKernelBenchmark] " << SOURCE_SIZE << "x" << SOURCE_SIZE << " -> " << TARGET_SIZE << "x" << TARGET_SIZE
+		<< ", " << iterations << " iterations" << std::endl;
+
+	//the loop loadSingleStreamAsset used before the kernels existed
+	{
+		sf::Image resized;
+		resized.create(TARGET_SIZE, TARGET_SIZE);
+
+		sf::Clock clock;
+		for (int i = 0; i < iterations; i++) {
+			for (unsigned int y = 0; y < TARGET_SIZE; y++) {
+				for (unsigned int x = 0; x < TARGET_SIZE; x++) {
+					resized.setPixel(x, y, source.getPixel(x * 2, y * 2));
+				}
+			}
+		}
+		report("getPixel/setPixel (nearest)", clock.getElapsedTime(), iterations);
+	}
+
+	std::vector<PixelKernels::Byte> target(TARGET_SIZE * TARGET_SIZE * 4);
+	const PixelKernels::Path previousPath = PixelKernels::getActivePath();
+
+	const PixelKernels::Path paths[] = { PixelKernels::Path::Scalar, PixelKernels::Path::SSE2, PixelKernels::Path::AVX2 };
+	for (PixelKernels::Path path : paths) {
+		if (!PixelKernels::isPathSupported(path)) {
+			std::cout << "[PixelKernelBenchmark] " << PixelKernels::getPathName(path) << " not supported on this CPU" << std::endl;
+			continue;
+		}
+
+		PixelKernels::setActivePath(path);
+
+		sf::Clock clock;
+		for (int i = 0; i < iterations; i++) {
+			PixelKernels::downscale2x(source.getPixelsPtr(), SOURCE_SIZE, SOURCE_SIZE, target.data());
+		}
+		report(PixelKernels::getPathName(path), clock.getElapsedTime(), iterations);
+	}
+
+	PixelKernels::setActivePath(previousPath);
+
+	//fractional factor goes through the generic area filter
+	{
+		const unsigned int fractionalSize = 200;
+		std::vector<PixelKernels::Byte> fractional(fractionalSize * fractionalSize * 4);
+
+		sf::Clock clock;
+		for (int i = 0; i < iterations; i++) {
+			PixelKernels::resize(source.getPixelsPtr(), SOURCE_SIZE, SOURCE_SIZE, fractional.data(), fractionalSize, fractionalSize);
+		}
+		report("area filter (512 -> 200)", clock.getElapsedTime(), iterations);
+	}
+}
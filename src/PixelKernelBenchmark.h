@@ -0,0 +1,10 @@
+#pragma once
+
+/* Microbenchmark for the streaming icon resize. Compares the original getPixel/setPixel nearest-neighbour loop
+ * against every PixelKernels path the CPU supports. Run the executable with --bench-resize.
+ */
+class PixelKernelBenchmark
+{
+public:
+	static void run(int iterations = 200);
+};
@@ -0,0 +1,303 @@
+#include "PixelKernels.h"
+#include <atomic>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//GCC and Clang only emit AVX2 instructions inside functions that opt in; MSVC always allows the intrinsics
+#if defined(PIXEL_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PIXEL_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PIXEL_KERNELS_TARGET_AVX2
+#endif
+
+typedef PixelKernels::Byte Byte;
+typedef void (*Downscale2xRowFn)(const Byte* row0, const Byte* row1, Byte* dst, unsigned int dstWidth);
+
+namespace
+{
+	//averages pairs of pixels from two source rows into dstWidth output pixels, rounding to nearest
+	void downscale2xRowScalar(const Byte* row0, const Byte* row1, Byte* dst, unsigned int dstWidth)
+	{
+		for (unsigned int x = 0; x < dstWidth; x++) {
+			const Byte* a = row0 + x * 8;
+			const Byte* b = row1 + x * 8;
+			for (int c = 0; c < 4; c++) {
+				dst[x * 4 + c] = static_cast<Byte>((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+			}
+		}
+	}
+
+#ifdef PIXEL_KERNELS_X86
+	//8 source pixels -> 4 output pixels per iteration
+	void downscale2xRowSSE2(const Byte* row0, const Byte* row1, Byte* dst, unsigned int dstWidth)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i rounding = _mm_set1_epi16(2);
+
+		unsigned int x = 0;
+		for (; x + 4 <= dstWidth; x += 4) {
+			const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+			const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16));
+			const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+			const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16));
+
+			//vertical sums, two source pixels per register
+			const __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+			const __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+			const __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+			const __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+			//horizontal sums of neighbouring pixels
+			__m128i lo = _mm_add_epi16(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+			__m128i hi = _mm_add_epi16(_mm_unpacklo_epi64(s45, s67), _mm_unpackhi_epi64(s45, s67));
+			lo = _mm_srli_epi16(_mm_add_epi16(lo, rounding), 2);
+			hi = _mm_srli_epi16(_mm_add_epi16(hi, rounding), 2);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(lo, hi));
+		}
+
+		downscale2xRowScalar(row0 + x * 8, row1 + x * 8, dst + x * 4, dstWidth - x);
+	}
+
+	PIXEL_KERNELS_TARGET_AVX2 __m256i sumPixelPairsAVX2(const Byte* row0, const Byte* row1)
+	{
+		//4 source pixels widened to 16 bits, one pixel pair per 128-bit lane
+		const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0)));
+		const __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1)));
+		const __m256i v = _mm256_add_epi16(a, b);
+		return _mm256_add_epi16(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	//16 source pixels -> 8 output pixels per iteration
+	PIXEL_KERNELS_TARGET_AVX2 void downscale2xRowAVX2(const Byte* row0, const Byte* row1, Byte* dst, unsigned int dstWidth)
+	{
+		const __m256i rounding = _mm256_set1_epi16(2);
+		const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+		unsigned int x = 0;
+		for (; x + 8 <= dstWidth; x += 8) {
+			const Byte* a = row0 + x * 8;
+			const Byte* b = row1 + x * 8;
+
+			const __m256i p0 = sumPixelPairsAVX2(a, b);
+			const __m256i p1 = sumPixelPairsAVX2(a + 16, b + 16);
+			const __m256i p2 = sumPixelPairsAVX2(a + 32, b + 32);
+			const __m256i p3 = sumPixelPairsAVX2(a + 48, b + 48);
+
+			//lane 0 holds outputs 0,2,4,6 and lane 1 holds 1,3,5,7 after packing
+			__m256i lo = _mm256_unpacklo_epi64(p0, p1);
+			__m256i hi = _mm256_unpacklo_epi64(p2, p3);
+			lo = _mm256_srli_epi16(_mm256_add_epi16(lo, rounding), 2);
+			hi = _mm256_srli_epi16(_mm256_add_epi16(hi, rounding), 2);
+
+			const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), packed);
+		}
+
+		downscale2xRowSSE2(row0 + x * 8, row1 + x * 8, dst + x * 4, dstWidth - x);
+	}
+
+	bool cpuSupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) {
+			return false;
+		}
+
+		//AVX needs OSXSAVE and the OS saving the YMM registers
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+			return false;
+		}
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif
+
+	Downscale2xRowFn getRowKernel(PixelKernels::Path path)
+	{
+		switch (path) {
+#ifdef PIXEL_KERNELS_X86
+		case PixelKernels::Path::AVX2: return downscale2xRowAVX2;
+		case PixelKernels::Path::SSE2: return downscale2xRowSSE2;
+#endif
+		default: return downscale2xRowScalar;
+		}
+	}
+
+	std::atomic<Downscale2xRowFn> activeRowKernel(nullptr);
+	std::atomic<PixelKernels::Path> activePath(PixelKernels::Path::Scalar);
+
+	Downscale2xRowFn resolveRowKernel()
+	{
+		Downscale2xRowFn kernel = activeRowKernel.load(std::memory_order_acquire);
+		if (kernel == nullptr) {
+			PixelKernels::Path path = PixelKernels::getBestSupportedPath();
+			activePath.store(path);
+			kernel = getRowKernel(path);
+			activeRowKernel.store(kernel, std::memory_order_release);
+		}
+		return kernel;
+	}
+
+	//fixed-point (16.16) coverage of one destination pixel over the source axis
+	struct Footprint
+	{
+		unsigned int first;
+		std::vector<std::uint32_t> weights;
+	};
+
+	std::vector<Footprint> buildFootprints(unsigned int srcSize, unsigned int dstSize)
+	{
+		std::vector<Footprint> footprints(dstSize);
+		const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+		for (unsigned int d = 0; d < dstSize; d++) {
+			double start = d * scale;
+			double end = start + scale;
+			unsigned int first = static_cast<unsigned int>(start);
+			unsigned int last = static_cast<unsigned int>(end);
+			if (last >= srcSize) last = srcSize - 1;
+
+			Footprint& footprint = footprints[d];
+			footprint.first = first;
+
+			//weights always sum to 65536 so a flat colour stays exactly the same
+			std::uint32_t assigned = 0;
+			for (unsigned int s = first; s <= last; s++) {
+				double left = s > start ? s : start;
+				double right = (s + 1) < end ? (s + 1) : end;
+				std::uint32_t weight = right > left ? static_cast<std::uint32_t>((right - left) / scale * 65536.0) : 0;
+				footprint.weights.push_back(weight);
+				assigned += weight;
+			}
+			footprint.weights[0] += 65536 - assigned;
+		}
+
+		return footprints;
+	}
+}
+
+void PixelKernels::downscale2x(const Byte* src, unsigned int srcWidth, unsigned int srcHeight, Byte* dst)
+{
+	const Downscale2xRowFn kernel = resolveRowKernel();
+	const unsigned int dstWidth = srcWidth / 2;
+	const unsigned int dstHeight = srcHeight / 2;
+	const unsigned int srcStride = srcWidth * 4;
+
+	for (unsigned int y = 0; y < dstHeight; y++) {
+		const Byte* row0 = src + (y * 2) * srcStride;
+		kernel(row0, row0 + srcStride, dst + y * dstWidth * 4, dstWidth);
+	}
+}
+
+void PixelKernels::resize(const Byte* src, unsigned int srcWidth, unsigned int srcHeight, Byte* dst, unsigned int dstWidth, unsigned int dstHeight)
+{
+	if (srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+		return;
+	}
+
+	if (srcWidth == dstWidth * 2 && srcHeight == dstHeight * 2) {
+		downscale2x(src, srcWidth, srcHeight, dst);
+		return;
+	}
+
+	//separable box filter: horizontal pass into 16.16 accumulators, then vertical pass
+	const std::vector<Footprint> columns = buildFootprints(srcWidth, dstWidth);
+	const std::vector<Footprint> rows = buildFootprints(srcHeight, dstHeight);
+
+	std::vector<std::uint32_t> horizontal(static_cast<size_t>(dstWidth) * srcHeight * 4);
+	for (unsigned int y = 0; y < srcHeight; y++) {
+		const Byte* srcRow = src + static_cast<size_t>(y) * srcWidth * 4;
+		std::uint32_t* outRow = horizontal.data() + static_cast<size_t>(y) * dstWidth * 4;
+
+		for (unsigned int x = 0; x < dstWidth; x++) {
+			const Footprint& footprint = columns[x];
+			std::uint32_t sum[4] = { 0, 0, 0, 0 };
+			for (size_t i = 0; i < footprint.weights.size(); i++) {
+				const Byte* pixel = srcRow + (footprint.first + i) * 4;
+				for (int c = 0; c < 4; c++) {
+					sum[c] += pixel[c] * footprint.weights[i];
+				}
+			}
+			for (int c = 0; c < 4; c++) {
+				outRow[x * 4 + c] = sum[c];
+			}
+		}
+	}
+
+	for (unsigned int y = 0; y < dstHeight; y++) {
+		const Footprint& footprint = rows[y];
+		Byte* dstRow = dst + static_cast<size_t>(y) * dstWidth * 4;
+
+		for (unsigned int x = 0; x < dstWidth * 4; x++) {
+			std::uint64_t sum = 0;
+			for (size_t i = 0; i < footprint.weights.size(); i++) {
+				sum += static_cast<std::uint64_t>(horizontal[(footprint.first + i) * dstWidth * 4 + x]) * footprint.weights[i];
+			}
+			dstRow[x] = static_cast<Byte>((sum + (1ull << 31)) >> 32);
+		}
+	}
+}
+
+PixelKernels::Path PixelKernels::getBestSupportedPath()
+{
+	if (isPathSupported(Path::AVX2)) return Path::AVX2;
+	if (isPathSupported(Path::SSE2)) return Path::SSE2;
+	return Path::Scalar;
+}
+
+bool PixelKernels::isPathSupported(Path path)
+{
+	switch (path) {
+#ifdef PIXEL_KERNELS_X86
+	case Path::AVX2: {
+		static const bool supported = cpuSupportsAVX2();
+		return supported;
+	}
+	case Path::SSE2: return true; //baseline on every x86 target we build for
+#endif
+	case Path::Scalar: return true;
+	default: return false;
+	}
+}
+
+PixelKernels::Path PixelKernels::getActivePath()
+{
+	resolveRowKernel();
+	return activePath.load();
+}
+
+void PixelKernels::setActivePath(Path path)
+{
+	if (!isPathSupported(path)) {
+		return;
+	}
+
+	activePath.store(path);
+	activeRowKernel.store(getRowKernel(path), std::memory_order_release);
+}
+
+const char* PixelKernels::getPathName(Path path)
+{
+	switch (path) {
+	case Path::AVX2: return "AVX2";
+	case Path::SSE2: return "SSE2";
+	default: return "Scalar";
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+/* Resampling kernels that work directly on tightly packed RGBA8 buffers (4 bytes per pixel, no row padding).
+ * The 2x2 box filter has SSE2 and AVX2 paths that are picked at runtime, with a scalar fallback for
+ * other CPUs. Any other scale factor, integer or fractional, goes through an area-averaging box filter.
+ */
+class PixelKernels
+{
+public:
+	typedef std::uint8_t Byte;
+
+	enum class Path { Scalar, SSE2, AVX2 };
+
+	//averages every 2x2 block of src into one pixel of dst. dst must hold (srcWidth / 2) x (srcHeight / 2) pixels.
+	static void downscale2x(const Byte* src, unsigned int srcWidth, unsigned int srcHeight, Byte* dst);
+
+	//area-averaging resize to any size. Uses downscale2x when the factor is exactly 2 on both axes.
+	static void resize(const Byte* src, unsigned int srcWidth, unsigned int srcHeight, Byte* dst, unsigned int dstWidth, unsigned int dstHeight);
+
+	static Path getBestSupportedPath();
+	static bool isPathSupported(Path path);
+	static Path getActivePath();
+	static void setActivePath(Path path); //forces a path, used by the benchmark. Ignored if the CPU does not support it.
+	static const char* getPathName(Path path);
+};
@@ -5,6 +5,9 @@
 
 PokeballAnimation::PokeballAnimation(String name) : AGameObject(name)
 {
+    this->setNameIndexed(true);
+    this->setThreadSafeUpdate(true); // Only advances its own animation
+    this->setRenderLayer(RenderLayer::Overlay);
 }
 
 void PokeballAnimation::initialize()
@@ -15,9 +18,9 @@ void PokeballAnimation::initialize()
 
     this->setPosition(xPosition, yPosition);
 
-    if (!animationFrames.empty() && this->sprite != nullptr)
+    if (!animationFrames.empty())
     {
-        this->sprite->setTexture(*animationFrames[0]);
+        this->getSprite()->setTexture(*animationFrames[0]);
 
         sf::FloatRect bounds = this->sprite->getLocalBounds();
         this->sprite->setOrigin(bounds.width / 2.0f, bounds.height / 2.0f);
@@ -107,7 +110,7 @@ void PokeballAnimation::updateAnimation(sf::Time deltaTime)
         }
 
 
-        if (this->sprite != nullptr && currentFrame < animationFrames.size())
+        if (this->sprite.has_value() && currentFrame < animationFrames.size())
         {
             this->sprite->setTexture(*animationFrames[currentFrame]);
         }
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "TaskSlab.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only callable stored by value in the pool's queues. Captures up to INLINE_SIZE bytes live inside the
+// task itself; larger ones go to the owning pool's TaskSlab. Either way scheduling does no per-task new/delete.
+class PoolTask {
+public:
+    static const size_t INLINE_SIZE = 48;
+
+    PoolTask() noexcept : ops(nullptr) {}
+
+    template <class F, class Fn = std::decay_t<F>,
+        std::enable_if_t<!std::is_same_v<Fn, PoolTask> && std::is_invocable_v<Fn&>, int> = 0>
+    PoolTask(F&& _fn, TaskSlab* _slab = nullptr) : ops(nullptr)
+    {
+        if constexpr (fitsInline<Fn>()) {
+            ::new (static_cast<void*>(storage)) Fn(std::forward<F>(_fn));
+            ops = &inlineOps<Fn>;
+        }
+        else {
+            TaskSlab* slab = usesSlab<Fn>() ? _slab : nullptr;
+            void* block = slab != nullptr
+                ? slab->Allocate(sizeof(Fn))
+                : ::operator new(sizeof(Fn), std::align_val_t(externalAlignment<Fn>()));
+            ::new (block) Fn(std::forward<F>(_fn));
+            ::new (static_cast<void*>(storage)) External{ block, slab };
+            ops = &externalOps<Fn>;
+        }
+    }
+
+    PoolTask(PoolTask&& _other) noexcept : ops(_other.ops)
+    {
+        if (ops != nullptr) {
+            ops->move(storage, _other.storage);
+            _other.ops = nullptr;
+        }
+    }
+
+    PoolTask& operator=(PoolTask&& _other) noexcept
+    {
+        if (this != &_other) {
+            reset();
+            ops = _other.ops;
+            if (ops != nullptr) {
+                ops->move(storage, _other.storage);
+                _other.ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    PoolTask(const PoolTask&) = delete;
+    PoolTask& operator=(const PoolTask&) = delete;
+
+    ~PoolTask() { reset(); }
+
+    void operator()() { ops->invoke(storage); }
+    explicit operator bool() const { return ops != nullptr; }
+
+    void reset()
+    {
+        if (ops != nullptr) {
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* _storage);
+        void (*move)(void* _dst, void* _src); // move-constructs into _dst and destroys _src
+        void (*destroy)(void* _storage);
+    };
+
+    struct External {
+        void* object;
+        TaskSlab* slab;
+    };
+
+    template <class Fn>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    // slab blocks are only aligned to max_align_t
+    template <class Fn>
+    static constexpr bool usesSlab()
+    {
+        return alignof(Fn) <= alignof(std::max_align_t);
+    }
+
+    template <class Fn>
+    static constexpr size_t externalAlignment()
+    {
+        return alignof(Fn) > alignof(std::max_align_t) ? alignof(Fn) : alignof(std::max_align_t);
+    }
+
+    template <class Fn>
+    static constexpr Ops inlineOps = {
+        [](void* _storage) { (*static_cast<Fn*>(_storage))(); },
+        [](void* _dst, void* _src) {
+            Fn* source = static_cast<Fn*>(_src);
+            ::new (_dst) Fn(std::move(*source));
+            source->~Fn();
+        },
+        [](void* _storage) { static_cast<Fn*>(_storage)->~Fn(); }
+    };
+
+    template <class Fn>
+    static constexpr Ops externalOps = {
+        [](void* _storage) { (*static_cast<Fn*>(static_cast<External*>(_storage)->object))(); },
+        [](void* _dst, void* _src) { ::new (_dst) External(*static_cast<External*>(_src)); },
+        [](void* _storage) {
+            External* external = static_cast<External*>(_storage);
+            static_cast<Fn*>(external->object)->~Fn();
+            if (external->slab != nullptr) {
+                external->slab->Deallocate(external->object, sizeof(Fn));
+            }
+            else {
+                ::operator delete(external->object, std::align_val_t(externalAlignment<Fn>()));
+            }
+        }
+    };
+
+    alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+    const Ops* ops;
+};
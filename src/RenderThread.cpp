@@ -0,0 +1,116 @@
+#include "RenderThread.h"
+#include <iostream>
+
+RenderThread::RenderThread()
+{
+	for (int i = 0; i < DRAW_LIST_COUNT; i++) {
+		this->drawLists.push_back(std::make_unique<DrawList>());
+		this->freeLists.push_back(this->drawLists.back().get());
+	}
+}
+
+RenderThread::~RenderThread()
+{
+	this->stop();
+}
+
+void RenderThread::start(sf::RenderWindow* window)
+{
+	if (this->running) {
+		return;
+	}
+
+	this->window = window;
+	this->stopRequested = false;
+	this->running = true;
+
+	//a context can only be active on one thread at a time
+	this->window->setActive(false);
+	this->thread = std::thread(&RenderThread::run, this);
+
+	std::cout << "[RenderThread] Started with " << this->drawLists.size() << " draw lists" << std::endl;
+}
+
+void RenderThread::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		if (!this->running) {
+			return;
+		}
+		this->stopRequested = true;
+	}
+	this->cv.notify_all();
+
+	if (this->thread.joinable()) {
+		this->thread.join();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->running = false;
+		if (this->readyList != nullptr) {
+			this->freeLists.push_back(this->readyList);
+			this->readyList = nullptr;
+		}
+	}
+
+	this->window->setActive(true);
+	std::cout << "[RenderThread] Stopped" << std::endl;
+}
+
+DrawList* RenderThread::acquireDrawList()
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+	//recording ahead of a frame that was not even picked up yet would only be thrown away or queue up latency
+	this->cv.wait(lock, [this] { return (this->readyList == nullptr && !this->freeLists.empty()) || this->stopRequested; });
+	if (this->stopRequested) {
+		return NULL;
+	}
+
+	DrawList* list = this->freeLists.back();
+	this->freeLists.pop_back();
+	list->clear();
+	return list;
+}
+
+void RenderThread::submitDrawList(DrawList* list)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->readyList = list;
+	}
+	this->cv.notify_all();
+}
+
+void RenderThread::run()
+{
+	this->window->setActive(true);
+
+	while (true) {
+		DrawList* list;
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->cv.wait(lock, [this] { return this->readyList != nullptr || this->stopRequested; });
+			if (this->stopRequested) {
+				break;
+			}
+			list = this->readyList;
+			this->readyList = nullptr;
+		}
+		//the update thread may record the next frame while this one is drawn
+		this->cv.notify_all();
+
+		this->window->clear();
+		list->execute(*this->window);
+		this->window->display();
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->freeLists.push_back(list);
+		}
+		this->cv.notify_all();
+	}
+
+	this->window->setActive(false);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "DrawList.h"
+
+/* Owns the window's GL context and draws the frames the update thread records. The update thread records one
+ * frame while the previous one is drawn, and waits before recording another until the render thread has picked
+ * up the last one, so it never runs more than a frame ahead and no recorded frame is thrown away.
+ */
+class RenderThread : sf::NonCopyable
+{
+public:
+	RenderThread();
+	~RenderThread();
+
+	void start(sf::RenderWindow* window); //the window is deactivated on the calling thread
+	void stop(); //finishes the frame being drawn, then hands the context back to the calling thread
+
+	DrawList* acquireDrawList(); //blocks until the last submitted list was picked up, NULL once stopped
+	void submitDrawList(DrawList* list);
+
+private:
+	static const int DRAW_LIST_COUNT = 2; //one being drawn, one being recorded
+
+	sf::RenderWindow* window = nullptr;
+
+	std::vector<std::unique_ptr<DrawList>> drawLists;
+	std::vector<DrawList*> freeLists;
+	DrawList* readyList = nullptr;
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool running = false;
+	bool stopRequested = false;
+
+	void run();
+};
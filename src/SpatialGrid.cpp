@@ -0,0 +1,152 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(BoundsGetter getBounds, float cellSize)
+{
+	this->getBounds = getBounds;
+	this->cellSize = cellSize;
+}
+
+void SpatialGrid::insert(int id)
+{
+	if (id >= static_cast<int>(this->entries.size())) {
+		this->entries.resize(id + 1);
+	}
+
+	Entry& entry = this->entries[id];
+	if (entry.inGrid) {
+		return;
+	}
+
+	//binned on the next query, once the owner has finished placing it
+	entry.inGrid = true;
+	entry.dirty = true;
+	this->dirtyIds.push_back(id);
+	this->objectCount++;
+}
+
+void SpatialGrid::remove(int id)
+{
+	if (id < 0 || id >= static_cast<int>(this->entries.size()) || !this->entries[id].inGrid) {
+		return;
+	}
+
+	Entry& entry = this->entries[id];
+	if (!entry.dirty) {
+		this->unbin(id);
+	}
+	else {
+		this->dirtyIds.erase(std::remove(this->dirtyIds.begin(), this->dirtyIds.end(), id), this->dirtyIds.end());
+	}
+
+	entry.inGrid = false;
+	entry.dirty = false;
+	this->objectCount--;
+}
+
+void SpatialGrid::markDirty(int id)
+{
+	if (id < 0 || id >= static_cast<int>(this->entries.size())) {
+		return;
+	}
+
+	Entry& entry = this->entries[id];
+	if (!entry.inGrid || entry.dirty) {
+		return;
+	}
+
+	this->unbin(id);
+	entry.dirty = true;
+	this->dirtyIds.push_back(id);
+}
+
+void SpatialGrid::query(const sf::FloatRect& area, std::vector<int>& ids)
+{
+	this->refreshDirtyEntries();
+	this->currentStamp++;
+
+	sf::IntRect range = this->getCellRange(area);
+	for (int y = range.top; y < range.top + range.height; y++) {
+		for (int x = range.left; x < range.left + range.width; x++) {
+			auto cell = this->cells.find(getCellKey(x, y));
+			if (cell == this->cells.end()) {
+				continue;
+			}
+
+			for (int id : cell->second) {
+				Entry& entry = this->entries[id];
+				//items spanning several cells are seen more than once
+				if (entry.queryStamp == this->currentStamp || !entry.bounds.intersects(area)) {
+					continue;
+				}
+				entry.queryStamp = this->currentStamp;
+				ids.push_back(id);
+			}
+		}
+	}
+}
+
+int SpatialGrid::getObjectCount() const
+{
+	return this->objectCount;
+}
+
+void SpatialGrid::refreshDirtyEntries()
+{
+	for (int id : this->dirtyIds) {
+		Entry& entry = this->entries[id];
+		entry.bounds = this->getBounds(id);
+		entry.cells = this->getCellRange(entry.bounds);
+		entry.dirty = false;
+		this->bin(id);
+	}
+	this->dirtyIds.clear();
+}
+
+void SpatialGrid::bin(int id)
+{
+	const sf::IntRect& range = this->entries[id].cells;
+	for (int y = range.top; y < range.top + range.height; y++) {
+		for (int x = range.left; x < range.left + range.width; x++) {
+			this->cells[getCellKey(x, y)].push_back(id);
+		}
+	}
+}
+
+void SpatialGrid::unbin(int id)
+{
+	const sf::IntRect& range = this->entries[id].cells;
+	for (int y = range.top; y < range.top + range.height; y++) {
+		for (int x = range.left; x < range.left + range.width; x++) {
+			auto cell = this->cells.find(getCellKey(x, y));
+			if (cell == this->cells.end()) {
+				continue;
+			}
+
+			std::vector<int>& ids = cell->second;
+			auto found = std::find(ids.begin(), ids.end(), id);
+			if (found != ids.end()) {
+				*found = ids.back();
+				ids.pop_back();
+			}
+			if (ids.empty()) {
+				this->cells.erase(cell);
+			}
+		}
+	}
+}
+
+sf::IntRect SpatialGrid::getCellRange(const sf::FloatRect& bounds) const
+{
+	int left = static_cast<int>(std::floor(bounds.left / this->cellSize));
+	int top = static_cast<int>(std::floor(bounds.top / this->cellSize));
+	int right = static_cast<int>(std::floor((bounds.left + bounds.width) / this->cellSize));
+	int bottom = static_cast<int>(std::floor((bounds.top + bounds.height) / this->cellSize));
+	return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+std::int64_t SpatialGrid::getCellKey(int x, int y)
+{
+	return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+}
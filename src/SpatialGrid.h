@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/* Coarse uniform grid over the world bounds of cullable items. Items are small non-negative ids chosen by the owner
+ * (a slot index, an icon index), binned into every cell their bounds touch and only re-binned after they report a
+ * move, so a query costs the number of cells it covers plus the items found there, not the number of items.
+ */
+class SpatialGrid
+{
+public:
+	typedef std::function<sf::FloatRect(int)> BoundsGetter;
+
+	SpatialGrid(BoundsGetter getBounds, float cellSize = 256.0f);
+
+	void insert(int id);
+	void remove(int id);
+	void markDirty(int id); //called by the owner when the item's bounds change
+
+	//appends the id of every item whose bounds intersect the area, each once and in no particular order
+	void query(const sf::FloatRect& area, std::vector<int>& ids);
+	int getObjectCount() const;
+
+private:
+	struct Entry
+	{
+		sf::FloatRect bounds;
+		sf::IntRect cells; //covered cell range, width and height are cell counts
+		unsigned int queryStamp = 0;
+		bool inGrid = false;
+		bool dirty = false;
+	};
+
+	BoundsGetter getBounds;
+	float cellSize;
+	std::vector<Entry> entries; //indexed by id
+	std::unordered_map<std::int64_t, std::vector<int>> cells; //cell -> ids
+	std::vector<int> dirtyIds;
+	unsigned int currentStamp = 0;
+	int objectCount = 0;
+
+	void refreshDirtyEntries();
+	void bin(int id);
+	void unbin(int id);
+	sf::IntRect getCellRange(const sf::FloatRect& bounds) const;
+	static std::int64_t getCellKey(int x, int y);
+};
@@ -0,0 +1,304 @@
+#include "SpriteBatch.h"
+#include "DrawList.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	//multiplies the regular textured (or untextured) output by a group opacity
+	const char* OPACITY_FRAGMENT_SHADER =
+		"uniform sampler2D texture;\n"
+		"uniform float hasTexture;\n"
+		"uniform float opacity;\n"
+		"void main()\n"
+		"{\n"
+		"    vec4 pixel = hasTexture > 0.5 ? texture2D(texture, gl_TexCoord[0].xy) : vec4(1.0);\n"
+		"    gl_FragColor = gl_Color * pixel * vec4(1.0, 1.0, 1.0, opacity);\n"
+		"}\n";
+}
+
+bool SpriteBatch::DrawRange::operator==(const DrawRange& other) const
+{
+	return this->texture == other.texture && this->firstVertex == other.firstVertex && this->vertexCount == other.vertexCount;
+}
+
+void SpriteBatch::begin()
+{
+	this->clearSubmitted();
+	this->runIndex = 0;
+	this->quadCount = 0;
+	this->drawCallCount = 0;
+	this->reusedRunCount = 0;
+}
+
+void SpriteBatch::submit(const sf::Sprite& sprite, int layer)
+{
+	//an untextured sprite draws nothing in SFML either
+	if (sprite.getTexture() == nullptr) {
+		return;
+	}
+
+	this->submit(sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor(), layer);
+}
+
+void SpriteBatch::submit(const sf::Texture* texture, const sf::IntRect& textureRect, const sf::Transform& transform, sf::Color color, int layer)
+{
+	//same geometry as sf::Sprite: the local quad is the size of the texture rect, a negative size flips the texcoords
+	sf::FloatRect localRect(0.0f, 0.0f,
+		static_cast<float>(std::abs(textureRect.width)), static_cast<float>(std::abs(textureRect.height)));
+	sf::FloatRect texCoords(static_cast<float>(textureRect.left), static_cast<float>(textureRect.top),
+		static_cast<float>(textureRect.width), static_cast<float>(textureRect.height));
+
+	this->appendQuad(texture, localRect, texCoords, transform, color, layer);
+}
+
+void SpriteBatch::submitRect(const sf::FloatRect& rect, sf::Color color, int layer)
+{
+	this->appendQuad(nullptr, rect, sf::FloatRect(), sf::Transform::Identity, color, layer);
+}
+
+void SpriteBatch::submitRect(const sf::Texture* texture, const sf::FloatRect& rect, const sf::FloatRect& textureRect, sf::Color color, int layer)
+{
+	this->appendQuad(texture, rect, textureRect, sf::Transform::Identity, color, layer);
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target, float opacity)
+{
+	if (this->quads.empty()) {
+		return;
+	}
+
+	//a fully transparent group costs nothing to draw
+	if (opacity <= 0.0f) {
+		this->clearSubmitted();
+		return;
+	}
+
+	this->checkGraphicsSupport();
+	this->sortSubmitted();
+
+	bool shaderOpacity = opacity < 1.0f && this->useOpacityShader;
+	if (opacity < 1.0f && !shaderOpacity) {
+		this->applyOpacityToVertices(opacity);
+	}
+
+	if (this->runIndex == this->runs.size()) {
+		this->runs.push_back(std::make_unique<Run>());
+	}
+	Run& run = *this->runs[this->runIndex++];
+
+	//a run identical to last frame's keeps its uploaded buffer
+	bool unchanged = run.vertices.size() == this->sortedVertices.size() && run.ranges == this->sortedRanges &&
+		std::memcmp(run.vertices.data(), this->sortedVertices.data(), this->sortedVertices.size() * sizeof(sf::Vertex)) == 0;
+
+	if (unchanged) {
+		this->reusedRunCount++;
+	}
+	else {
+		run.vertices.swap(this->sortedVertices);
+		run.ranges.swap(this->sortedRanges);
+
+		if (this->useVertexBuffer) {
+			if (run.vertices.size() > run.bufferCapacity) {
+				run.buffer.create(run.vertices.size());
+				run.bufferCapacity = run.vertices.size();
+			}
+			run.buffer.update(run.vertices.data(), run.vertices.size(), 0);
+		}
+	}
+
+	if (shaderOpacity) {
+		this->opacityShader.setUniform("opacity", opacity);
+	}
+
+	for (const DrawRange& range : run.ranges) {
+		sf::RenderStates states;
+		states.texture = range.texture;
+
+		if (shaderOpacity) {
+			this->opacityShader.setUniform("hasTexture", range.texture != nullptr ? 1.0f : 0.0f);
+			states.shader = &this->opacityShader;
+		}
+
+		if (this->useVertexBuffer) {
+			target.draw(run.buffer, range.firstVertex, range.vertexCount, states);
+		}
+		else {
+			target.draw(&run.vertices[range.firstVertex], range.vertexCount, sf::Triangles, states);
+		}
+		this->drawCallCount++;
+	}
+
+	this->clearSubmitted();
+}
+
+void SpriteBatch::flush(DrawList& list, float opacity)
+{
+	if (this->quads.empty()) {
+		return;
+	}
+
+	if (opacity <= 0.0f) {
+		this->clearSubmitted();
+		return;
+	}
+
+	//the render thread has no access to the opacity shader, so fades are baked into the recorded vertices
+	this->sortSubmitted();
+	if (opacity < 1.0f) {
+		this->applyOpacityToVertices(opacity);
+	}
+
+	for (const DrawRange& range : this->sortedRanges) {
+		list.addVertices(&this->sortedVertices[range.firstVertex], range.vertexCount, range.texture);
+		this->drawCallCount++;
+	}
+
+	this->clearSubmitted();
+}
+
+int SpriteBatch::getQuadCount() const
+{
+	return this->quadCount;
+}
+
+int SpriteBatch::getDrawCallCount() const
+{
+	return this->drawCallCount;
+}
+
+int SpriteBatch::getReusedRunCount() const
+{
+	return this->reusedRunCount;
+}
+
+void SpriteBatch::appendQuad(const sf::Texture* texture, const sf::FloatRect& localRect, const sf::FloatRect& textureRect,
+	const sf::Transform& transform, sf::Color color, int layer)
+{
+	float left = localRect.left;
+	float top = localRect.top;
+	float right = localRect.left + localRect.width;
+	float bottom = localRect.top + localRect.height;
+
+	float u0 = textureRect.left;
+	float v0 = textureRect.top;
+	float u1 = textureRect.left + textureRect.width;
+	float v1 = textureRect.top + textureRect.height;
+
+	sf::Vertex topLeft(transform.transformPoint(left, top), color, sf::Vector2f(u0, v0));
+	sf::Vertex topRight(transform.transformPoint(right, top), color, sf::Vector2f(u1, v0));
+	sf::Vertex bottomLeft(transform.transformPoint(left, bottom), color, sf::Vector2f(u0, v1));
+	sf::Vertex bottomRight(transform.transformPoint(right, bottom), color, sf::Vector2f(u1, v1));
+
+	float minX = std::min(std::min(topLeft.position.x, topRight.position.x), std::min(bottomLeft.position.x, bottomRight.position.x));
+	float maxX = std::max(std::max(topLeft.position.x, topRight.position.x), std::max(bottomLeft.position.x, bottomRight.position.x));
+	float minY = std::min(std::min(topLeft.position.y, topRight.position.y), std::min(bottomLeft.position.y, bottomRight.position.y));
+	float maxY = std::max(std::max(topLeft.position.y, topRight.position.y), std::max(bottomLeft.position.y, bottomRight.position.y));
+	sf::FloatRect bounds(minX, minY, maxX - minX, maxY - minY);
+
+	this->quads.push_back(Quad{ layer, texture, bounds, this->submittedVertices.size(), -1 });
+
+	this->submittedVertices.push_back(topLeft);
+	this->submittedVertices.push_back(bottomLeft);
+	this->submittedVertices.push_back(topRight);
+	this->submittedVertices.push_back(topRight);
+	this->submittedVertices.push_back(bottomLeft);
+	this->submittedVertices.push_back(bottomRight);
+
+	this->quadCount++;
+}
+
+void SpriteBatch::sortSubmitted()
+{
+	//layers are explicit draw order; inside a layer submission order is painter's order, so stable
+	std::stable_sort(this->quads.begin(), this->quads.end(), [](const Quad& a, const Quad& b) {
+		return a.layer < b.layer;
+	});
+
+	//a quad joins the newest earlier group of its texture only if no group after that one overlaps it,
+	//so moving it back cannot change which of two overlapping quads ends up on top
+	this->groups.clear();
+	size_t layerFirstGroup = 0;
+	for (int quadIndex = 0; quadIndex < static_cast<int>(this->quads.size()); quadIndex++) {
+		Quad& quad = this->quads[quadIndex];
+		if (quadIndex > 0 && this->quads[quadIndex - 1].layer != quad.layer) {
+			layerFirstGroup = this->groups.size();
+		}
+
+		Group* target = nullptr;
+		size_t searchEnd = this->groups.size() - std::min(this->groups.size() - layerFirstGroup, static_cast<size_t>(MAX_MERGE_LOOKBACK));
+		for (size_t i = this->groups.size(); i > searchEnd; i--) {
+			Group& group = this->groups[i - 1];
+			if (group.texture == quad.texture) {
+				target = &group;
+				break;
+			}
+			if (group.bounds.intersects(quad.bounds)) {
+				break;
+			}
+		}
+
+		if (target == nullptr) {
+			this->groups.push_back(Group{ quad.texture, quad.bounds, quadIndex, quadIndex });
+			continue;
+		}
+
+		float left = std::min(target->bounds.left, quad.bounds.left);
+		float top = std::min(target->bounds.top, quad.bounds.top);
+		float right = std::max(target->bounds.left + target->bounds.width, quad.bounds.left + quad.bounds.width);
+		float bottom = std::max(target->bounds.top + target->bounds.height, quad.bounds.top + quad.bounds.height);
+		target->bounds = sf::FloatRect(left, top, right - left, bottom - top);
+
+		this->quads[target->lastQuad].nextInGroup = quadIndex;
+		target->lastQuad = quadIndex;
+	}
+
+	this->sortedVertices.clear();
+	this->sortedRanges.clear();
+	for (const Group& group : this->groups) {
+		if (this->sortedRanges.empty() || this->sortedRanges.back().texture != group.texture) {
+			this->sortedRanges.push_back(DrawRange{ group.texture, this->sortedVertices.size(), 0 });
+		}
+
+		for (int quadIndex = group.firstQuad; quadIndex >= 0; quadIndex = this->quads[quadIndex].nextInGroup) {
+			const sf::Vertex* source = &this->submittedVertices[this->quads[quadIndex].firstVertex];
+			this->sortedVertices.insert(this->sortedVertices.end(), source, source + VERTICES_PER_QUAD);
+			this->sortedRanges.back().vertexCount += VERTICES_PER_QUAD;
+		}
+	}
+}
+
+void SpriteBatch::clearSubmitted()
+{
+	this->submittedVertices.clear();
+	this->quads.clear();
+	this->groups.clear();
+}
+
+void SpriteBatch::checkGraphicsSupport()
+{
+	//needs a GL context, so it cannot be asked in the constructor
+	if (this->checkedGraphicsSupport) {
+		return;
+	}
+	this->checkedGraphicsSupport = true;
+
+	this->useVertexBuffer = sf::VertexBuffer::isAvailable();
+
+	if (sf::Shader::isAvailable() && this->opacityShader.loadFromMemory(OPACITY_FRAGMENT_SHADER, sf::Shader::Fragment)) {
+		this->opacityShader.setUniform("texture", sf::Shader::CurrentTexture);
+		this->useOpacityShader = true;
+	}
+	else {
+		std::cout << "[SpriteBatch] Opacity shader unavailable, group fades fall back to vertex colours" << std::endl;
+	}
+}
+
+void SpriteBatch::applyOpacityToVertices(float opacity)
+{
+	for (sf::Vertex& vertex : this->sortedVertices) {
+		vertex.color.a = static_cast<sf::Uint8>(vertex.color.a * opacity);
+	}
+}
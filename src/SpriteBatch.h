@@ -0,0 +1,95 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+class DrawList;
+
+/* Collects textured quads and draws them with as few draw calls as possible. Quads are grouped by layer and keep
+ * their submission order inside it; a quad only moves back to join an earlier run of its texture when nothing
+ * submitted in between overlaps it, so non-overlapping icons on an atlas page still go out in one call without
+ * changing what ends up on top. Anything drawn around the batch must call flush() first to keep the draw order. A run of quads that did not
+ * change since the previous frame reuses its vertex buffer without uploading again. Group opacity is a shader
+ * uniform, so fading a whole run does not touch its vertices; without shader support the alpha is written into
+ * the vertex colours instead.
+ */
+class SpriteBatch : sf::NonCopyable
+{
+public:
+	void begin(); //once per frame, before the first submit
+	void submit(const sf::Sprite& sprite, int layer);
+	void submit(const sf::Texture* texture, const sf::IntRect& textureRect, const sf::Transform& transform, sf::Color color, int layer);
+	void submitRect(const sf::FloatRect& rect, sf::Color color, int layer); //untextured quad, e.g. a fade overlay
+	void submitRect(const sf::Texture* texture, const sf::FloatRect& rect, const sf::FloatRect& textureRect, sf::Color color, int layer);
+	void flush(sf::RenderTarget& target, float opacity = 1.0f); //opacity scales the alpha of everything in this flush
+	void flush(DrawList& list, float opacity = 1.0f); //records the sorted quads for the render thread instead of drawing
+
+	int getQuadCount() const; //per frame
+	int getDrawCallCount() const;
+	int getReusedRunCount() const;
+
+private:
+	struct Quad
+	{
+		int layer;
+		const sf::Texture* texture;
+		sf::FloatRect bounds;
+		size_t firstVertex;
+		int nextInGroup; //next quad drawn in the same group, -1 for the last
+	};
+
+	//quads that can be drawn together without reordering anything that overlaps
+	struct Group
+	{
+		const sf::Texture* texture;
+		sf::FloatRect bounds;
+		int firstQuad;
+		int lastQuad;
+	};
+
+	struct DrawRange
+	{
+		const sf::Texture* texture;
+		size_t firstVertex;
+		size_t vertexCount;
+
+		bool operator==(const DrawRange& other) const;
+	};
+
+	//vertices drawn by one flush, kept across frames so an unchanged run can skip the upload
+	struct Run
+	{
+		std::vector<sf::Vertex> vertices;
+		std::vector<DrawRange> ranges;
+		sf::VertexBuffer buffer = sf::VertexBuffer(sf::Triangles, sf::VertexBuffer::Dynamic);
+		size_t bufferCapacity = 0;
+	};
+
+	static const int VERTICES_PER_QUAD = 6;
+	static const int MAX_MERGE_LOOKBACK = 16; //groups searched backwards for one a quad can join
+
+	std::vector<sf::Vertex> submittedVertices;
+	std::vector<Quad> quads;
+	std::vector<Group> groups;
+
+	std::vector<std::unique_ptr<Run>> runs;
+	size_t runIndex = 0;
+	std::vector<sf::Vertex> sortedVertices;
+	std::vector<DrawRange> sortedRanges;
+
+	bool checkedGraphicsSupport = false;
+	bool useVertexBuffer = false;
+	bool useOpacityShader = false;
+	sf::Shader opacityShader;
+
+	int quadCount = 0;
+	int drawCallCount = 0;
+	int reusedRunCount = 0;
+
+	void appendQuad(const sf::Texture* texture, const sf::FloatRect& localRect, const sf::FloatRect& textureRect,
+		const sf::Transform& transform, sf::Color color, int layer);
+	void sortSubmitted();
+	void clearSubmitted();
+	void checkGraphicsSupport();
+	void applyOpacityToVertices(float opacity);
+};
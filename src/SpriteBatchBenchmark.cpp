@@ -0,0 +1,114 @@
+#include "SpriteBatchBenchmark.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "SpriteBatch.h"
+
+namespace
+{
+	const unsigned int TARGET_WIDTH = 1920;
+	const unsigned int TARGET_HEIGHT = 1080;
+	const unsigned int PAGE_SIZE = 1024;
+	const int ICON_SIZE = 64;
+	const int PAGE_COUNT = 3;
+
+	//reusedFrames counts the frames whose vertices were not uploaded again, -1 when no batch was used
+	void report(const char* label, sf::Time total, int frames, int drawCalls, int reusedFrames = -1)
+	{
+		std::cout << "[SpriteBatchBenchmark] " << std::left << std::setw(20) << label
+			<< std::right << std::setw(9) << std::fixed << std::setprecision(3)
+			<< (total.asMicroseconds() / 1000.0 / frames) << " ms/frame"
+			<< std::setw(8) << drawCalls << " draw calls";
+		if (reusedFrames >= 0) {
+			std::cout << std::setw(8) << reusedFrames << "/" << frames << " frames reused";
+		}
+		std::cout << std::endl;
+	}
+}
+
+void SpriteBatchBenchmark::run(int spriteCount, int frames)
+{
+	sf::RenderTexture target;
+	if (!target.create(TARGET_WIDTH, TARGET_HEIGHT)) {
+		std::cout << "[SpriteBatchBenchmark] Could not create an offscreen render target" << std::endl;
+		return;
+	}
+
+	//a few atlas-sized pages, like the streamed icons
+	std::vector<sf::Texture> pages(PAGE_COUNT);
+	for (int i = 0; i < PAGE_COUNT; i++) {
+		sf::Image image;
+		image.create(PAGE_SIZE, PAGE_SIZE, sf::Color(80 * i, 255 - 80 * i, 128));
+		pages[i].loadFromImage(image);
+	}
+
+	const int iconsPerRow = PAGE_SIZE / ICON_SIZE;
+	const int iconsPerPage = iconsPerRow * iconsPerRow;
+	const int columns = TARGET_WIDTH / 16;
+
+	std::vector<sf::Sprite> sprites(spriteCount);
+	for (int i = 0; i < spriteCount; i++) {
+		int slot = i % iconsPerPage;
+		sprites[i].setTexture(pages[(i / iconsPerPage) % PAGE_COUNT]);
+		sprites[i].setTextureRect(sf::IntRect((slot % iconsPerRow) * ICON_SIZE, (slot / iconsPerRow) * ICON_SIZE, ICON_SIZE, ICON_SIZE));
+		sprites[i].setPosition(static_cast<float>((i % columns) * 16), static_cast<float>((i / columns) * 16 % TARGET_HEIGHT));
+		sprites[i].setScale(0.25f, 0.25f);
+	}
+
+	//each measurement ends with a read back, which waits for the GPU, so the timings include the rendering
+	std::cout << "[SpriteBatchBenchmark] " << spriteCount << " sprites on " << PAGE_COUNT << " textures, "
+		<< frames << " frames" << std::endl;
+
+	{
+		sf::Clock clock;
+		for (int frame = 0; frame < frames; frame++) {
+			target.clear();
+			for (const sf::Sprite& sprite : sprites) {
+				target.draw(sprite);
+			}
+			target.display();
+		}
+		target.getTexture().copyToImage();
+		report("one call per sprite", clock.getElapsedTime(), frames, spriteCount);
+	}
+
+	SpriteBatch batch;
+
+	//every sprite moves each frame, so the batch is rebuilt and uploaded every time
+	{
+		int reusedFrames = 0;
+		sf::Clock clock;
+		for (int frame = 0; frame < frames; frame++) {
+			target.clear();
+			batch.begin();
+			for (sf::Sprite& sprite : sprites) {
+				sprite.move(0.0f, frame % 2 == 0 ? 1.0f : -1.0f);
+				batch.submit(sprite, 0);
+			}
+			batch.flush(target);
+			reusedFrames += batch.getReusedRunCount();
+			target.display();
+		}
+		target.getTexture().copyToImage();
+		report("batch (moving)", clock.getElapsedTime(), frames, batch.getDrawCallCount(), reusedFrames);
+	}
+
+	//nothing changes, so every frame after the first reuses the uploaded vertices
+	{
+		int reusedFrames = 0;
+		sf::Clock clock;
+		for (int frame = 0; frame < frames; frame++) {
+			target.clear();
+			batch.begin();
+			for (const sf::Sprite& sprite : sprites) {
+				batch.submit(sprite, 0);
+			}
+			batch.flush(target);
+			reusedFrames += batch.getReusedRunCount();
+			target.display();
+		}
+		target.getTexture().copyToImage();
+		report("batch (static)", clock.getElapsedTime(), frames, batch.getDrawCallCount(), reusedFrames);
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+/* Draws a large sprite catalog into an offscreen target, once with one draw call per sprite and once through
+ * SpriteBatch (moving and static). Run the executable with --bench-batch.
+ */
+class SpriteBatchBenchmark
+{
+public:
+	static void run(int spriteCount = 10000, int frames = 240);
+};
@@ -0,0 +1,62 @@
+#include "StreamLoadTracker.h"
+
+void StreamLoadTracker::reset(int count)
+{
+	this->states.reset(new std::atomic<State>[count]);
+	for (int i = 0; i < count; i++) {
+		this->states[i].store(State::Idle, std::memory_order_relaxed);
+	}
+	this->count = count;
+}
+
+int StreamLoadTracker::size() const
+{
+	return this->count;
+}
+
+bool StreamLoadTracker::tryQueue(int index)
+{
+	return this->transition(index, State::Idle, State::Queued);
+}
+
+bool StreamLoadTracker::tryBeginDecode(int index)
+{
+	return this->transition(index, State::Queued, State::Decoding);
+}
+
+void StreamLoadTracker::cancelQueued(int index)
+{
+	this->transition(index, State::Queued, State::Idle);
+}
+
+void StreamLoadTracker::finish(int index, bool succeeded)
+{
+	this->transition(index, State::Decoding, succeeded ? State::Done : State::Failed);
+}
+
+void StreamLoadTracker::failUpload(int index)
+{
+	this->transition(index, State::Done, State::Failed);
+}
+
+StreamLoadTracker::State StreamLoadTracker::getState(int index) const
+{
+	if (index < 0 || index >= this->count) {
+		return State::Idle;
+	}
+	return this->states[index].load(std::memory_order_acquire);
+}
+
+bool StreamLoadTracker::isResolved(int index) const
+{
+	State state = this->getState(index);
+	return state == State::Done || state == State::Failed;
+}
+
+bool StreamLoadTracker::transition(int index, State from, State to)
+{
+	if (index < 0 || index >= this->count) {
+		return false;
+	}
+	return this->states[index].compare_exchange_strong(from, to, std::memory_order_acq_rel);
+}
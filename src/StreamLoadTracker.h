@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/* Per-index state of streaming loads. The main thread queues indices, workers claim them before decoding,
+ * so an index that is already queued, decoding or finished is never scheduled again.
+ */
+class StreamLoadTracker
+{
+public:
+	enum class State : std::uint8_t { Idle, Queued, Decoding, Done, Failed };
+
+	void reset(int count);
+	int size() const;
+
+	bool tryQueue(int index); //main thread: Idle -> Queued
+	bool tryBeginDecode(int index); //worker: Queued -> Decoding
+	void cancelQueued(int index); //worker: Queued -> Idle, for a task dropped before it started
+	void finish(int index, bool succeeded); //main thread: Decoding -> Done / Failed
+	void failUpload(int index); //main thread: Done -> Failed, for an asset that decoded but could not be uploaded
+
+	State getState(int index) const;
+	bool isResolved(int index) const; //done or failed, nothing more will happen to it
+
+private:
+	std::unique_ptr<std::atomic<State>[]> states;
+	int count = 0;
+
+	bool transition(int index, State from, State to);
+};
@@ -0,0 +1,108 @@
+#include "StreamingManifest.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+StreamingManifest::StreamingManifest(const String& streamingPath, const String& manifestPath)
+{
+	this->streamingPath = streamingPath;
+	this->manifestPath = manifestPath;
+}
+
+void StreamingManifest::build(bool forceScan)
+{
+	this->fileNames.clear();
+
+	if (!forceScan && this->readFromFile())
+	{
+		std::cout << "[StreamingManifest] Read " << this->fileNames.size() << " entries from " << this->manifestPath << std::endl;
+	}
+	else
+	{
+		this->scanDirectory();
+		std::cout << "[StreamingManifest] Scanned " << this->fileNames.size() << " entries from " << this->streamingPath << std::endl;
+	}
+
+	//sorting keeps index -> file stable between runs and machines
+	std::sort(this->fileNames.begin(), this->fileNames.end());
+	this->rebuildPaths();
+}
+
+bool StreamingManifest::writeToFile() const
+{
+	std::ofstream stream(this->manifestPath);
+	if (!stream.is_open()) {
+		std::cerr << "[StreamingManifest] ERROR: Failed to write manifest: " << this->manifestPath << std::endl;
+		return false;
+	}
+
+	for (const String& fileName : this->fileNames)
+	{
+		stream << fileName << "\n";
+	}
+
+	std::cout << "[StreamingManifest] Wrote " << this->fileNames.size() << " entries to " << this->manifestPath << std::endl;
+	return true;
+}
+
+int StreamingManifest::size() const
+{
+	return static_cast<int>(this->fileNames.size());
+}
+
+const StreamingManifest::String& StreamingManifest::getPath(int index) const
+{
+	return this->paths[index];
+}
+
+const StreamingManifest::String& StreamingManifest::getFileName(int index) const
+{
+	return this->fileNames[index];
+}
+
+bool StreamingManifest::readFromFile()
+{
+	std::ifstream stream(this->manifestPath);
+	if (!stream.is_open()) {
+		return false;
+	}
+
+	String line;
+	while (std::getline(stream, line))
+	{
+		//tolerate CRLF manifests and blank lines
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (!line.empty()) {
+			this->fileNames.push_back(line);
+		}
+	}
+
+	return !this->fileNames.empty();
+}
+
+void StreamingManifest::scanDirectory()
+{
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(this->streamingPath, error)) {
+		if (entry.is_regular_file()) {
+			this->fileNames.push_back(entry.path().filename().string());
+		}
+	}
+
+	if (error) {
+		std::cerr << "[StreamingManifest] ERROR: Failed to scan " << this->streamingPath << ": " << error.message() << std::endl;
+	}
+}
+
+void StreamingManifest::rebuildPaths()
+{
+	this->paths.clear();
+	this->paths.reserve(this->fileNames.size());
+	for (const String& fileName : this->fileNames)
+	{
+		this->paths.push_back(this->streamingPath + fileName);
+	}
+}
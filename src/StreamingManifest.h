@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/* Sorted, stable table of the streaming assets. Built once (from a generated manifest file if one exists,
+ * otherwise by scanning the streaming directory) so that index -> path lookups are O(1) and the load order
+ * does not depend on the order the filesystem returns directory entries in.
+ */
+class StreamingManifest
+{
+public:
+	typedef std::string String;
+
+	StreamingManifest(const String& streamingPath, const String& manifestPath);
+
+	void build(bool forceScan = false); //reads the manifest file, falls back to (or with forceScan, always does) a sorted directory scan
+	bool writeToFile() const; //writes the current table so later runs can skip the directory scan
+
+	int size() const;
+	const String& getPath(int index) const;
+	const String& getFileName(int index) const;
+
+private:
+	String streamingPath;
+	String manifestPath;
+
+	std::vector<String> fileNames;
+	std::vector<String> paths;
+
+	bool readFromFile();
+	void scanDirectory();
+	void rebuildPaths();
+};
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "ITaskExecutor.h"
+#include "PoolTask.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+template <class T>
+class TaskFuture;
+
+namespace TaskDetail
+{
+    // void results are stored as an empty value so one state type covers every future
+    template <class T> struct Stored { typedef T Type; };
+    template <> struct Stored<void> { typedef std::monostate Type; };
+
+    // Shared between a producer and the single TaskFuture that consumes it.
+    template <class T>
+    class SharedState {
+    public:
+        typedef typename Stored<T>::Type Value;
+
+        void SetValue(Value&& _value)
+        {
+            PoolTask continuation;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                value.emplace(std::move(_value));
+                continuation = publish();
+            }
+            if (continuation) continuation();
+        }
+
+        void SetError(std::exception_ptr _error)
+        {
+            PoolTask continuation;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                error = _error;
+                continuation = publish();
+            }
+            if (continuation) continuation();
+        }
+
+        // Runs _callback on the completing thread, or right away if the result is already in
+        void OnReady(PoolTask&& _callback)
+        {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!ready.load(std::memory_order_relaxed)) {
+                    continuation = std::move(_callback);
+                    return;
+                }
+            }
+            _callback();
+        }
+
+        bool IsReady() const { return ready.load(std::memory_order_acquire); }
+        void Wait() const { ready.wait(false, std::memory_order_acquire); }
+
+        bool HasError() const { return error != nullptr; }
+        std::exception_ptr GetError() const { return error; }
+
+        Value Take()
+        {
+            Wait();
+            if (error) std::rethrow_exception(error);
+            return std::move(*value);
+        }
+
+    private:
+        std::mutex stateMutex;
+        std::atomic<bool> ready{ false };
+        std::optional<Value> value;
+        std::exception_ptr error;
+        PoolTask continuation;
+
+        PoolTask publish()
+        {
+            ready.store(true, std::memory_order_release);
+            ready.notify_all();
+            return std::move(continuation);
+        }
+    };
+
+    // Calls _fn with the antecedent's value (nothing for void) and stores its result in _target
+    template <class R, class F, class... Args>
+    void Fulfill(SharedState<R>& _target, F& _fn, Args&&... _args)
+    {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                _fn(std::forward<Args>(_args)...);
+                _target.SetValue(std::monostate());
+            }
+            else {
+                _target.SetValue(_fn(std::forward<Args>(_args)...));
+            }
+        }
+        catch (...) {
+            _target.SetError(std::current_exception());
+        }
+    }
+
+    template <class T, class F>
+    struct ContinuationResult { typedef std::invoke_result_t<F&, T> Type; };
+    template <class F>
+    struct ContinuationResult<void, F> { typedef std::invoke_result_t<F&> Type; };
+
+    template <class T>
+    struct WhenAnyValue { typedef std::pair<size_t, T> Type; };
+    template <>
+    struct WhenAnyValue<void> { typedef size_t Type; };
+}
+
+// Result of a scheduled task. Move-only with a single consumer: either Get() it or chain one Then() onto it.
+template <class T>
+class TaskFuture {
+public:
+    typedef TaskDetail::SharedState<T> State;
+
+    TaskFuture() {}
+    explicit TaskFuture(std::shared_ptr<State> _state) : state(std::move(_state)) {}
+
+    TaskFuture(TaskFuture&&) = default;
+    TaskFuture& operator=(TaskFuture&&) = default;
+    TaskFuture(const TaskFuture&) = delete;
+    TaskFuture& operator=(const TaskFuture&) = delete;
+
+    bool IsValid() const { return state != nullptr; }
+    bool IsReady() const { return state->IsReady(); }
+    void Wait() const { state->Wait(); }
+
+    // Blocks until the value is available. Rethrows anything the task threw.
+    T Get()
+    {
+        std::shared_ptr<State> consumed = std::move(state);
+        if constexpr (std::is_void_v<T>) {
+            consumed->Take();
+        }
+        else {
+            return consumed->Take();
+        }
+    }
+
+    // Runs _fn(value) on _executor once this future completes. Errors skip _fn and flow into the returned future.
+    template <class F, class R = typename TaskDetail::ContinuationResult<T, std::decay_t<F>>::Type>
+    TaskFuture<R> Then(ITaskExecutor& _executor, F&& _fn)
+    {
+        auto next = std::make_shared<TaskDetail::SharedState<R>>();
+        std::shared_ptr<State> antecedent = std::move(state);
+        ITaskExecutor* executor = &_executor;
+
+        State* source = antecedent.get();
+        source->OnReady(PoolTask([executor, antecedent, next, fn = std::forward<F>(_fn)]() mutable {
+            executor->Execute(PoolTask([antecedent, next, fn = std::move(fn)]() mutable {
+                if (antecedent->HasError()) {
+                    next->SetError(antecedent->GetError());
+                }
+                else if constexpr (std::is_void_v<T>) {
+                    antecedent->Take();
+                    TaskDetail::Fulfill(*next, fn);
+                }
+                else {
+                    TaskDetail::Fulfill(*next, fn, antecedent->Take());
+                }
+            }, executor->GetTaskSlab()));
+        }));
+
+        return TaskFuture<R>(next);
+    }
+
+    // Hands the shared state to a combinator such as WhenAll; the future is empty afterwards
+    std::shared_ptr<State> DetachState() { return std::move(state); }
+
+private:
+    std::shared_ptr<State> state;
+};
+
+template <class T>
+TaskFuture<T> MakeReadyFuture(typename TaskDetail::Stored<T>::Type _value)
+{
+    auto state = std::make_shared<TaskDetail::SharedState<T>>();
+    state->SetValue(std::move(_value));
+    return TaskFuture<T>(state);
+}
+
+// Completes when every input has completed: with all values in input order, or with the first error seen.
+template <class T>
+TaskFuture<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> WhenAll(std::vector<TaskFuture<T>> _futures)
+{
+    typedef std::conditional_t<std::is_void_v<T>, void, std::vector<T>> Result;
+    typedef typename TaskDetail::Stored<T>::Type Value;
+
+    struct Join {
+        std::atomic<size_t> remaining;
+        std::vector<std::optional<Value>> values;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        std::shared_ptr<TaskDetail::SharedState<Result>> output;
+    };
+
+    auto output = std::make_shared<TaskDetail::SharedState<Result>>();
+    if (_futures.empty()) {
+        output->SetValue(typename TaskDetail::Stored<Result>::Type());
+        return TaskFuture<Result>(output);
+    }
+
+    auto join = std::make_shared<Join>();
+    join->remaining = _futures.size();
+    join->values.resize(_futures.size());
+    join->output = output;
+
+    for (size_t i = 0; i < _futures.size(); i++)
+    {
+        std::shared_ptr<TaskDetail::SharedState<T>> input = _futures[i].DetachState();
+        TaskDetail::SharedState<T>* source = input.get();
+        source->OnReady(PoolTask([join, input, i] {
+            if (input->HasError()) {
+                std::lock_guard<std::mutex> lock(join->errorMutex);
+                if (!join->error) join->error = input->GetError();
+            }
+            else {
+                join->values[i].emplace(input->Take());
+            }
+
+            if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+
+            if (join->error) {
+                join->output->SetError(join->error);
+            }
+            else if constexpr (std::is_void_v<T>) {
+                join->output->SetValue(std::monostate());
+            }
+            else {
+                std::vector<T> values;
+                values.reserve(join->values.size());
+                for (auto& value : join->values) values.push_back(std::move(*value));
+                join->output->SetValue(std::move(values));
+            }
+        }));
+    }
+
+    return TaskFuture<Result>(output);
+}
+
+// Completes with the first input to finish: its index (and value, for non-void futures), or its error.
+// An empty input has nothing to wait for and completes right away with std::invalid_argument.
+template <class T>
+TaskFuture<typename TaskDetail::WhenAnyValue<T>::Type> WhenAny(std::vector<TaskFuture<T>> _futures)
+{
+    typedef typename TaskDetail::WhenAnyValue<T>::Type Result;
+
+    struct Race {
+        std::atomic<bool> finished{ false };
+        std::shared_ptr<TaskDetail::SharedState<Result>> output;
+    };
+
+    auto race = std::make_shared<Race>();
+    race->output = std::make_shared<TaskDetail::SharedState<Result>>();
+    if (_futures.empty()) {
+        race->output->SetError(std::make_exception_ptr(std::invalid_argument("WhenAny called with no futures")));
+        return TaskFuture<Result>(race->output);
+    }
+
+    for (size_t i = 0; i < _futures.size(); i++)
+    {
+        std::shared_ptr<TaskDetail::SharedState<T>> input = _futures[i].DetachState();
+        TaskDetail::SharedState<T>* source = input.get();
+        source->OnReady(PoolTask([race, input, i] {
+            if (race->finished.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+
+            if (input->HasError()) {
+                race->output->SetError(input->GetError());
+            }
+            else if constexpr (std::is_void_v<T>) {
+                race->output->SetValue(i);
+            }
+            else {
+                race->output->SetValue(Result(i, input->Take()));
+            }
+        }));
+    }
+
+    return TaskFuture<Result>(race->output);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "PoolTask.h"
+#include <vector>
+
+// Growable circular buffer of PoolTasks. Unlike std::deque it keeps its storage once grown,
+// so pushing and popping tasks in steady state never allocates. Not thread-safe on its own.
+class TaskRing {
+public:
+    bool Empty() const { return count == 0; }
+    size_t Size() const { return count; }
+
+    void PushBack(PoolTask&& _task)
+    {
+        if (count == slots.size()) {
+            grow();
+        }
+        slots[(head + count) & (slots.size() - 1)] = std::move(_task);
+        count++;
+    }
+
+    PoolTask PopBack()
+    {
+        count--;
+        return std::move(slots[(head + count) & (slots.size() - 1)]);
+    }
+
+    PoolTask PopFront()
+    {
+        PoolTask task = std::move(slots[head]);
+        head = (head + 1) & (slots.size() - 1);
+        count--;
+        return task;
+    }
+
+    void Clear()
+    {
+        while (!Empty()) {
+            PopFront();
+        }
+    }
+
+private:
+    std::vector<PoolTask> slots;
+    size_t head = 0;
+    size_t count = 0;
+
+    void grow()
+    {
+        // capacity stays a power of two so wrapping is a mask
+        std::vector<PoolTask> larger(slots.empty() ? 64 : slots.size() * 2);
+        for (size_t i = 0; i < count; i++)
+        {
+            larger[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+        }
+        slots.swap(larger);
+        head = 0;
+    }
+};
@@ -0,0 +1,53 @@
+#include "TaskSlab.h"
+#include <new>
+
+TaskSlab::~TaskSlab()
+{
+    for (auto chunk : chunks)
+    {
+        ::operator delete(chunk, std::align_val_t(alignof(std::max_align_t)));
+    }
+}
+
+void* TaskSlab::Allocate(size_t _size)
+{
+    if (_size > BLOCK_SIZE) {
+        return ::operator new(_size, std::align_val_t(alignof(std::max_align_t)));
+    }
+
+    std::lock_guard<std::mutex> lock(slabMutex);
+    if (freeList == nullptr) {
+        addChunk();
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void TaskSlab::Deallocate(void* _block, size_t _size)
+{
+    if (_size > BLOCK_SIZE) {
+        ::operator delete(_block, std::align_val_t(alignof(std::max_align_t)));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(slabMutex);
+    FreeBlock* block = static_cast<FreeBlock*>(_block);
+    block->next = freeList;
+    freeList = block;
+}
+
+void TaskSlab::addChunk()
+{
+    unsigned char* chunk = static_cast<unsigned char*>(
+        ::operator new(BLOCK_SIZE * BLOCKS_PER_CHUNK, std::align_val_t(alignof(std::max_align_t))));
+    chunks.push_back(chunk);
+
+    for (size_t i = 0; i < BLOCKS_PER_CHUNK; i++)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * BLOCK_SIZE);
+        block->next = freeList;
+        freeList = block;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Freelist allocator for task captures that do not fit inside PoolTask's inline buffer.
+// Blocks are carved out of larger chunks and recycled, so steady-state scheduling never reaches the heap.
+// Allocation happens on the submitting thread and release on a worker, hence the lock.
+class TaskSlab {
+public:
+    static const size_t BLOCK_SIZE = 256;
+    static const size_t BLOCKS_PER_CHUNK = 64;
+
+    TaskSlab() {}
+    ~TaskSlab();
+    TaskSlab(const TaskSlab&) = delete;
+    TaskSlab& operator=(const TaskSlab&) = delete;
+
+    void* Allocate(size_t _size); // falls back to operator new above BLOCK_SIZE
+    void Deallocate(void* _block, size_t _size);
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::mutex slabMutex;
+    FreeBlock* freeList = nullptr;
+    std::vector<void*> chunks;
+
+    void addChunk();
+};
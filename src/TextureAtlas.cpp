@@ -0,0 +1,177 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding)
+{
+	this->pageSize = pageSize;
+	this->padding = padding;
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	for (Page& page : this->pages) {
+		delete page.texture;
+	}
+}
+
+bool TextureAtlas::insert(const sf::Uint8* pixels, unsigned int width, unsigned int height, Region& region)
+{
+	//querying the GL limit needs a context, so it waits until the first insert
+	if (this->pages.empty()) {
+		this->pageSize = std::min(this->pageSize, sf::Texture::getMaximumSize());
+	}
+
+	if (width + this->padding > this->pageSize || height + this->padding > this->pageSize) {
+		std::cout << "[TextureAtlas] Image " << width << "x" << height << " does not fit in a " << this->pageSize << " page" << std::endl;
+		return false;
+	}
+
+	sf::Vector2u position;
+	Page* target = nullptr;
+
+	for (Page& page : this->pages) {
+		if (this->allocate(page, width, height, position)) {
+			target = &page;
+			break;
+		}
+	}
+
+	if (target == nullptr) {
+		target = this->addPage();
+		if (target == nullptr || !this->allocate(*target, width, height, position)) {
+			return false;
+		}
+	}
+
+	target->texture->update(pixels, width, height, position.x, position.y);
+
+	region.page = target->texture;
+	region.rect = sf::IntRect(position.x, position.y, width, height);
+	return true;
+}
+
+int TextureAtlas::getPageCount() const
+{
+	return static_cast<int>(this->pages.size());
+}
+
+unsigned int TextureAtlas::getPageSize() const
+{
+	return this->pageSize;
+}
+
+bool TextureAtlas::allocate(Page& page, unsigned int width, unsigned int height, sf::Vector2u& position)
+{
+	//the padding keeps neighbouring images from bleeding into each other when sampled with filtering
+	const unsigned int paddedWidth = width + this->padding;
+	const unsigned int paddedHeight = height + this->padding;
+
+	size_t bestIndex = page.skyline.size();
+	unsigned int bestBottom = std::numeric_limits<unsigned int>::max();
+	unsigned int bestWidth = std::numeric_limits<unsigned int>::max();
+	unsigned int bestY = 0;
+
+	for (size_t i = 0; i < page.skyline.size(); i++) {
+		unsigned int y = 0;
+		if (!this->fits(page, i, paddedWidth, paddedHeight, y)) {
+			continue;
+		}
+
+		//bottom-left rule: lowest resulting edge first, then the narrowest level
+		const unsigned int bottom = y + paddedHeight;
+		if (bottom < bestBottom || (bottom == bestBottom && page.skyline[i].width < bestWidth)) {
+			bestIndex = i;
+			bestBottom = bottom;
+			bestWidth = page.skyline[i].width;
+			bestY = y;
+		}
+	}
+
+	if (bestIndex == page.skyline.size()) {
+		return false;
+	}
+
+	position = sf::Vector2u(page.skyline[bestIndex].x, bestY);
+	this->addSkylineLevel(page, bestIndex, position.x, bestY, paddedWidth, paddedHeight);
+	return true;
+}
+
+bool TextureAtlas::fits(const Page& page, size_t nodeIndex, unsigned int width, unsigned int height, unsigned int& y) const
+{
+	const unsigned int x = page.skyline[nodeIndex].x;
+	if (x + width > this->pageSize) {
+		return false;
+	}
+
+	//the image rests on the highest level it spans
+	y = page.skyline[nodeIndex].y;
+	unsigned int remaining = width;
+	for (size_t i = nodeIndex; remaining > 0; i++) {
+		if (i >= page.skyline.size()) {
+			return false;
+		}
+		y = std::max(y, page.skyline[i].y);
+		if (y + height > this->pageSize) {
+			return false;
+		}
+		remaining -= std::min(remaining, page.skyline[i].width);
+	}
+
+	return true;
+}
+
+void TextureAtlas::addSkylineLevel(Page& page, size_t nodeIndex, unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+	page.skyline.insert(page.skyline.begin() + nodeIndex, SkylineNode{ x, y + height, width });
+
+	//trim the levels now covered by the new one
+	for (size_t i = nodeIndex + 1; i < page.skyline.size(); ) {
+		SkylineNode& previous = page.skyline[i - 1];
+		SkylineNode& node = page.skyline[i];
+		const unsigned int previousEnd = previous.x + previous.width;
+		if (node.x >= previousEnd) {
+			break;
+		}
+
+		const unsigned int shrink = previousEnd - node.x;
+		if (node.width <= shrink) {
+			page.skyline.erase(page.skyline.begin() + i);
+			continue;
+		}
+
+		node.x += shrink;
+		node.width -= shrink;
+		break;
+	}
+
+	//merge neighbouring levels of the same height
+	for (size_t i = 0; i + 1 < page.skyline.size(); ) {
+		if (page.skyline[i].y == page.skyline[i + 1].y) {
+			page.skyline[i].width += page.skyline[i + 1].width;
+			page.skyline.erase(page.skyline.begin() + i + 1);
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+TextureAtlas::Page* TextureAtlas::addPage()
+{
+	sf::Texture* texture = new sf::Texture();
+	if (!texture->create(this->pageSize, this->pageSize)) {
+		std::cout << "[TextureAtlas] Failed to create a " << this->pageSize << "x" << this->pageSize << " atlas page" << std::endl;
+		delete texture;
+		return nullptr;
+	}
+
+	Page page;
+	page.texture = texture;
+	page.skyline.push_back(SkylineNode{ 0, 0, this->pageSize });
+	this->pages.push_back(page);
+
+	std::cout << "[TextureAtlas] Created atlas page " << this->pages.size() << " (" << this->pageSize << "x" << this->pageSize << ")" << std::endl;
+	return &this->pages.back();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/* Packs many small images into a few large textures ("pages"). Space inside a page is handed out by a skyline
+ * bottom-left allocator, so images of different sizes can share a page. Must be used from the thread that owns
+ * the GL context.
+ */
+class TextureAtlas : sf::NonCopyable
+{
+public:
+	struct Region
+	{
+		sf::Texture* page = nullptr;
+		sf::IntRect rect;
+	};
+
+	TextureAtlas(unsigned int pageSize = 4096, unsigned int padding = 1);
+	~TextureAtlas();
+
+	bool insert(const sf::Uint8* pixels, unsigned int width, unsigned int height, Region& region); //copies RGBA8 pixels into a free spot
+	int getPageCount() const;
+	unsigned int getPageSize() const;
+
+private:
+	struct SkylineNode
+	{
+		unsigned int x;
+		unsigned int y;
+		unsigned int width;
+	};
+
+	struct Page
+	{
+		sf::Texture* texture = nullptr;
+		std::vector<SkylineNode> skyline;
+	};
+
+	unsigned int pageSize;
+	unsigned int padding;
+	std::vector<Page> pages;
+
+	bool allocate(Page& page, unsigned int width, unsigned int height, sf::Vector2u& position);
+	bool fits(const Page& page, size_t nodeIndex, unsigned int width, unsigned int height, unsigned int& y) const;
+	void addSkylineLevel(Page& page, size_t nodeIndex, unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+	Page* addPage();
+};
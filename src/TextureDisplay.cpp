@@ -1,51 +1,80 @@
 #include "TextureDisplay.h"
 #include <iostream>
+#include <algorithm>
 #include "TextureManager.h"
 #include "BaseRunner.h"
 #include "GameObjectManager.h"
-#include "IconObject.h"
+#include "IconGrid.h"
+#include "IconChunkCache.h"
 #include "BGObject.h"
+#include "MainThreadDispatcher.h"
+#include "CameraManager.h"
 
 constexpr float BG_TRANSITION_DURATION_OVERRIDE = 1.0f; 
 
-TextureDisplay::TextureDisplay() : AGameObject("TextureDisplay")
+TextureDisplay::TextureDisplay() : AGameObject("TextureDisplay"),
+	TOTAL_TEXTURES(TextureManager::getInstance()->getStreamingAssetCount())
 {
 }
 
 TextureDisplay::~TextureDisplay()
 {
-	for (auto icon : iconList)
+	//drop queued loads and make sure no worker still runs one before the members go away
+	this->cancelStreamingLoads();
+	this->threadPool.StopScheduling();
+
+	//objects still on screen belong to the manager, which deletes them at the next frame boundary
+	if (iconGrid != nullptr)
 	{
-		delete icon;
+		GameObjectManager::getInstance()->deleteObject(iconGrid);
+	}
+	if (iconCache != nullptr)
+	{
+		GameObjectManager::getInstance()->deleteObject(iconCache);
 	}
-
 	if (loadingCharacter != nullptr)
 	{
-		delete loadingCharacter;
+		GameObjectManager::getInstance()->deleteObject(loadingCharacter);
 	}
 	if (loadingText != nullptr)
 	{
-		delete loadingText;
+		GameObjectManager::getInstance()->deleteObject(loadingText);
 	}
 	if (pokeballAnim != nullptr)
 	{
-		delete pokeballAnim;
+		GameObjectManager::getInstance()->deleteObject(pokeballAnim);
 	}
 }
 
 void TextureDisplay::initialize()
 {
 	TextureManager::getInstance()->initializeStreamTextureList(TOTAL_TEXTURES);
+	this->loadTracker.reset(TOTAL_TEXTURES);
+
+	//icons spawn hidden and fade in together through the layer opacity
+	GameObjectManager::getInstance()->setLayerOpacity(RenderLayer::World, 0.0f);
+
+	//the camera may show the whole grid and the screen it starts on, down to where the scroll ends
+	this->worldCamera = CameraManager::getInstance()->getCamera("World");
+	if (this->worldCamera != nullptr)
+	{
+		float left = std::min(GRID_OFFSET_X, 0.0f);
+		float top = std::min(GRID_OFFSET_Y, 0.0f);
+		float right = std::max(GRID_OFFSET_X + MAX_COLUMN * ICON_SPACING, static_cast<float>(BaseRunner::WINDOW_WIDTH));
+		float bottom = std::max(GRID_OFFSET_Y + MAX_ROW * ICON_SPACING, BaseRunner::WINDOW_HEIGHT + TOTAL_SCROLL_DISTANCE);
+		this->worldCamera->setContentBounds(sf::FloatRect(left, top, right - left, bottom - top));
+	}
+
+	iconGrid = GameObjectManager::getInstance()->createObject<IconGrid>("IconGrid", sf::Vector2f(GRID_OFFSET_X, GRID_OFFSET_Y), ICON_SPACING, MAX_COLUMN);
+	iconGrid->setRenderLayer(RenderLayer::World);
 
 	threadPool.StartScheduling();
 
-	loadingCharacter = new AnimatedCharacter("LoadingCharacter");
-	GameObjectManager::getInstance()->addObject(loadingCharacter);
+	loadingCharacter = GameObjectManager::getInstance()->createObject<AnimatedCharacter>("LoadingCharacter");
 
 	std::cout << "Loading character created" << std::endl;
 
-	loadingText = new LoadingText("LoadingText");
-	GameObjectManager::getInstance()->addObject(loadingText);
+	loadingText = GameObjectManager::getInstance()->createObject<LoadingText>("LoadingText");
 
 	std::cout << "Loading text created" << std::endl;
 }
@@ -56,52 +85,16 @@ void TextureDisplay::processInput(sf::Event event)
 
 void TextureDisplay::update(sf::Time deltaTime)
 {
-	this->ticks += deltaTime.asMilliseconds();
-
-	if (this->ticks > this->STREAMING_LOAD_DELAY) {
-		this->ticks = 0.0f;
-
-		int spawnedIconCount = this->iconList.size();
-		int loadedTextureCount = TextureManager::getInstance()->getNumLoadedStreamTextures();
-		int numReadyToSpawn = loadedTextureCount - spawnedIconCount;
-
-		if (numReadyToSpawn > 0 && !bgTransitionStarted) {
-			const int SPAWN_BATCH_SIZE = 30;
-			int numToSpawnThisBatch = std::min(numReadyToSpawn, SPAWN_BATCH_SIZE);
-
-			std::cout << "[MainThread] === Spawning BATCH of " << numToSpawnThisBatch
-				<< " icons (out of " << numReadyToSpawn << " ready) ===" << std::endl;
-
-			for (int i = 0; i < numToSpawnThisBatch; i++) {
-				int textureIndex = this->iconList.size();
-				if (textureIndex < loadedTextureCount)
-				{
-					this->spawnObject();
-				}
-			}
-		}
-
-		updateLoadingProgress();
-
-		const int LOAD_BATCH_SIZE = 30;
-		int totalTextures = TOTAL_TEXTURES;
-
-		if (loadedTextureCount < totalTextures && !bgTransitionStarted)
-		{
-			int texturesToLoad = std::min(LOAD_BATCH_SIZE, totalTextures - loadedTextureCount);
-
-			std::cout << "[MainThread] === Scheduling BATCH of " << texturesToLoad
-				<< " texture loads ===" << std::endl;
-
-			for (int i = 0; i < texturesToLoad; i++)
-			{
-				int textureIndex = loadedTextureCount + i;
-				LoadAssetThread* asset = new LoadAssetThread(textureIndex, this);
-				threadPool.ScheduleTask(asset);
-			}
-		}
+	//completions arrive through the main thread dispatcher every frame, so new work is submitted as soon as a load finishes
+	if (!bgTransitionStarted)
+	{
+		this->resolveFailedUploads();
+		this->spawnReadyIcons();
+		this->scheduleStreamingLoads();
 	}
 
+	updateLoadingProgress();
+
 
 	if (loadingComplete && !pokeballAnimStarted)
 	{
@@ -114,7 +107,7 @@ void TextureDisplay::update(sf::Time deltaTime)
 		{
 			pokeballAnimComplete = true;
 			std::cout << "[TextureDisplay] Pokeball animation complete!" << std::endl;
-			GameObjectManager::getInstance()->deleteObjectByName("PokeballAnim");
+			GameObjectManager::getInstance()->deleteObject(pokeballAnim);
 			pokeballAnim = nullptr;
 
 			if (!bgTransitionStarted) {
@@ -157,6 +150,98 @@ void TextureDisplay::update(sf::Time deltaTime)
 
 }
 
+void TextureDisplay::resolveFailedUploads()
+{
+	//a decode that could not be packed into the atlas never fills its slot, mark it failed so spawning moves past it
+	std::vector<int> failedIndices;
+	TextureManager::getInstance()->takeFailedUploads(failedIndices);
+	for (int textureIndex : failedIndices)
+	{
+		this->loadTracker.failUpload(textureIndex);
+	}
+}
+
+void TextureDisplay::spawnReadyIcons()
+{
+	//icons take their grid slot from their texture index, so spawn the contiguous run of published textures.
+	//a failed load still gets its (empty) slot so it cannot hold back the rest of the grid.
+	int spawnedThisFrame = 0;
+	while (spawnedThisFrame < SPAWN_BATCH_SIZE && this->spawnedIconCount < TOTAL_TEXTURES)
+	{
+		int textureIndex = this->spawnedIconCount;
+		if (TextureManager::getInstance()->getStreamTextureFromList(textureIndex) == nullptr &&
+			this->loadTracker.getState(textureIndex) != StreamLoadTracker::State::Failed)
+		{
+			break;
+		}
+
+		this->spawnObject();
+		spawnedThisFrame++;
+	}
+
+	if (spawnedThisFrame > 0)
+	{
+		std::cout << "[MainThread] Spawned " << spawnedThisFrame << " icons (" << this->spawnedIconCount
+			<< "/" << TOTAL_TEXTURES << ")" << std::endl;
+	}
+}
+
+void TextureDisplay::scheduleStreamingLoads()
+{
+	//keep every worker busy: refill the pipeline up to its capacity instead of waiting for a timer
+	const int maxInFlightLoads = this->threadPool.GetWorkerCount();
+
+	while (this->inFlightLoads < maxInFlightLoads && this->nextLoadIndex < TOTAL_TEXTURES)
+	{
+		int textureIndex = this->nextLoadIndex++;
+
+		//never decode the same index twice
+		if (!this->loadTracker.tryQueue(textureIndex))
+		{
+			continue;
+		}
+
+		this->inFlightLoads++;
+
+		CancellationToken token = this->loadCancellation;
+		StreamLoadTracker* tracker = &this->loadTracker;
+
+		//decode on a worker, then publish from the main thread
+		threadPool.ScheduleTask([textureIndex, token, tracker] {
+			if (token.IsCancelled() || !tracker->tryBeginDecode(textureIndex))
+			{
+				tracker->cancelQueued(textureIndex);
+				TextureManager::DecodedImage skipped;
+				skipped.index = textureIndex;
+				return skipped;
+			}
+			return TextureManager::getInstance()->decodeStreamAsset(textureIndex);
+		}).Then(*MainThreadDispatcher::getInstance(), [this, token](TextureManager::DecodedImage decoded) {
+			//the display may already be gone when a cancelled load reports back
+			if (token.IsCancelled())
+			{
+				return;
+			}
+
+			this->inFlightLoads--;
+			this->loadTracker.finish(decoded.index, !decoded.pixels.empty());
+			TextureManager::getInstance()->queueStreamUpload(std::move(decoded));
+			this->OnFinishedExecution();
+		});
+	}
+}
+
+void TextureDisplay::cancelStreamingLoads()
+{
+	if (this->loadCancellation.IsCancelled())
+	{
+		return;
+	}
+
+	this->loadCancellation.Cancel();
+	std::cout << "[TextureDisplay] Cancelled " << this->inFlightLoads << " pending streaming loads" << std::endl;
+}
+
 void TextureDisplay::OnFinishedExecution()
 {
 	std::cout << "[LoadThread] Texture loaded. Total: "
@@ -165,50 +250,47 @@ void TextureDisplay::OnFinishedExecution()
 
 void TextureDisplay::spawnObject()
 {
-	guard.lock();
-
-	String objectName = "Icon_" + std::to_string(this->iconList.size());
-	IconObject* iconObj = new IconObject(objectName, this->iconList.size());
-	this->iconList.push_back(iconObj);
-
-	int IMG_WIDTH = 68;
-	int IMG_HEIGHT = 68;
-	int OFFSET_X = -65;
-	int OFFSET_Y = -100;
-
-	float x = OFFSET_X + (this->columnGrid * IMG_WIDTH);
-	float y = OFFSET_Y + (this->rowGrid * IMG_HEIGHT);
+	//icons fill the grid in texture index order, a failed load leaves its slot blank
+	int textureIndex = this->spawnedIconCount;
+	iconGrid->addIcon(TextureManager::getInstance()->getStreamRegionFromList(textureIndex));
+	this->spawnedIconCount++;
+}
 
-	std::cout << "Set position: " << x << " " << y << std::endl;
+void TextureDisplay::bakeIconGrid()
+{
+	//the finished grid never changes again, so a few cached tiles replace it
+	sf::Vector2u iconSize = TextureManager::getInstance()->getStreamIconSize();
+	iconCache = GameObjectManager::getInstance()->createObject<IconChunkCache>("IconChunkCache", sf::Vector2f(GRID_OFFSET_X, GRID_OFFSET_Y),
+		ICON_SPACING, iconSize, MAX_COLUMN, ROWS_PER_CHUNK);
+	iconCache->setRenderLayer(RenderLayer::World);
 
-	this->columnGrid++;
-	if (this->columnGrid == this->MAX_COLUMN)
+	for (int i = 0; i < iconGrid->getIconCount(); i++)
 	{
-		this->columnGrid = 0;
-		this->rowGrid++;
+		iconCache->setIcon(i, iconGrid->getIconRegion(i));
 	}
 
-	GameObjectManager::getInstance()->addObject(iconObj);
-	iconObj->setPosition(x, y);
-	iconObj->setTransparency(0);
+	GameObjectManager::getInstance()->deleteObject(iconGrid);
+	iconGrid = nullptr;
 
-	guard.unlock();
+	std::cout << "[TextureDisplay] Cached " << this->spawnedIconCount << " icons in " << iconCache->getChunkCount() << " chunks" << std::endl;
 }
 
 void TextureDisplay::updateLoadingProgress()
 {
 	if (loadingCharacter == nullptr) return;
 
-	int loadedCount = TextureManager::getInstance()->getNumLoadedStreamTextures();
+	//failed loads count as resolved so a missing file cannot stall the sequence
+	int loadedCount = TextureManager::getInstance()->getNumLoadedStreamTextures() +
+		TextureManager::getInstance()->getNumFailedStreamTextures();
 	float progress = static_cast<float>(loadedCount) / static_cast<float>(TOTAL_TEXTURES);
 	loadingCharacter->updateProgress(progress);
 
 	
-	int spawnedCount = static_cast<int>(iconList.size());
+	int spawnedCount = this->spawnedIconCount;
 
 	// Only mark loading as complete when:
 	//  - all textures are loaded, AND
-	//  - all icon objects have been spawned into iconList.
+	//  - all icons have been spawned into the icon grid.
 	if (loadedCount >= TOTAL_TEXTURES && spawnedCount >= TOTAL_TEXTURES && !loadingComplete)
 	{
 		std::cout << "Loading complete! All textures loaded and all icons spawned. Ready for pokeball animation..." << std::endl;
@@ -216,17 +298,19 @@ void TextureDisplay::updateLoadingProgress()
 
 		if (loadingCharacter != nullptr)
 		{
-			GameObjectManager::getInstance()->deleteObjectByName("LoadingCharacter");
+			GameObjectManager::getInstance()->deleteObject(loadingCharacter);
 			loadingCharacter = nullptr;
 			std::cout << "Removed loading character" << std::endl;
 		}
 
 		if (loadingText != nullptr)
 		{
-			GameObjectManager::getInstance()->deleteObjectByName("LoadingText");
+			GameObjectManager::getInstance()->deleteObject(loadingText);
 			loadingText = nullptr;
 			std::cout << "Removed loading text" << std::endl;
 		}
+
+		this->bakeIconGrid();
 	}
 	else if (loadedCount >= TOTAL_TEXTURES && spawnedCount < TOTAL_TEXTURES)
 	{
@@ -238,8 +322,7 @@ void TextureDisplay::startPokeballAnimation()
 {
 	if (pokeballAnim == nullptr)
 	{
-		pokeballAnim = new PokeballAnimation("PokeballAnim");
-		GameObjectManager::getInstance()->addObject(pokeballAnim);
+		pokeballAnim = GameObjectManager::getInstance()->createObject<PokeballAnimation>("PokeballAnim");
 		pokeballAnimStarted = true;
 		std::cout << "Pokeball animation started!" << std::endl;
 	}
@@ -257,6 +340,7 @@ void TextureDisplay::startBackgroundTransition()
 	{
 		bgObject->startTransitionToBg2();
 		bgTransitionStarted = true;
+		this->cancelStreamingLoads();
 		bgTransitionTimer = 0.0f;
 	}
 }
@@ -279,12 +363,8 @@ void TextureDisplay::updateIconFadeIn(sf::Time deltaTime)
 		std::cout << "Icon fade-in complete!" << std::endl;
 	}
 
-	//   icon transparencies
-	int alpha = static_cast<int>(iconFadeProgress * 255);
-	for (auto icon : iconList)
-	{
-		icon->setTransparency(alpha);
-	}
+	//one opacity for the whole grid instead of a colour change on every icon
+	GameObjectManager::getInstance()->setLayerOpacity(RenderLayer::World, iconFadeProgress);
 }
 
 void TextureDisplay::updateScrollAnimation(sf::Time deltaTime)
@@ -298,35 +378,19 @@ void TextureDisplay::updateScrollAnimation(sf::Time deltaTime)
 			isScrolling = true;
 			scrollTimer = 0.0f;
 			std::cout << "Starting scroll animation..." << std::endl;
+
+			//the icons stay where they are, the world camera pans over them
+			if (worldCamera != nullptr)
+			{
+				worldCamera->panBy(sf::Vector2f(0.0f, TOTAL_SCROLL_DISTANCE), SCROLL_DURATION, MathUtils::Easing::QuadInOut);
+			}
 		}
 		return;
 	}
 
-	// Animate scrolling
-	scrollTimer += deltaTime.asSeconds();
-	float progress = std::min(scrollTimer / SCROLL_DURATION, 1.0f);
-
-	// Smooth easing (ease-in-out)
-	float easedProgress = progress < 0.5f
-		? 2.0f * progress * progress
-		: 1.0f - std::pow(-2.0f * progress + 2.0f, 2.0f) / 2.0f;
-
-	currentScrollOffset = easedProgress * TOTAL_SCROLL_DISTANCE;
-
-	// Apply offset to all icons
-	for (size_t i = 0; i < iconList.size(); i++)
-	{
-		int col = i % MAX_COLUMN;
-		int row = i / MAX_COLUMN;
-
-		float baseX = -65 + (col * 68);
-		float baseY = -100 + (row * 68);
-
-		iconList[i]->setPosition(baseX, baseY - currentScrollOffset);
-	}
-
-	if (progress >= 1.0f)
+	if (!scrollComplete && (worldCamera == nullptr || !worldCamera->isAnimating()))
 	{
-		std::cout << "Scroll animation complete! All 620 icons shown." << std::endl;
+		scrollComplete = true;
+		std::cout << "Scroll animation complete! All " << TOTAL_TEXTURES << " icons shown." << std::endl;
 	}
-}
\ No newline at end of file
+}
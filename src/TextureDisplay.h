@@ -2,14 +2,17 @@
 #include "AGameObject.h"
 #include "LoadAssetThread.h"
 
-#include <mutex>
 #include "ThreadPool.h"
 #include "AnimatedCharacter.h"
 #include "LoadingText.h"
 #include "PokeballAnimation.h"
+#include "StreamLoadTracker.h"
+#include "CancellationToken.h"
 
 
-class IconObject;
+class IconGrid;
+class IconChunkCache;
+class Camera;
 
 class TextureDisplay : public AGameObject, public IExecutionEvent
 {
@@ -22,24 +25,29 @@ public:
 	void OnFinishedExecution() override;
 
 private:
-	typedef std::vector<IconObject*> IconList;
-	IconList iconList;
+	IconGrid* iconGrid = nullptr; //owned by the game object manager
+	int spawnedIconCount = 0;
+	IconChunkCache* iconCache = nullptr; //replaces the icon grid once it is complete
+	const int ROWS_PER_CHUNK = 4;
 
-	ThreadPool threadPool = ThreadPool(30);
+	//declared before the pool so they outlive any task still referencing them
+	StreamLoadTracker loadTracker;
+	CancellationToken loadCancellation;
+
+	ThreadPool threadPool = ThreadPool(30, ThreadPool::SchedulingMode::WorkStealing);
 	AnimatedCharacter* loadingCharacter = nullptr;
 	LoadingText* loadingText = nullptr;
 
-	const int TOTAL_TEXTURES = 620;
-	const float STREAMING_LOAD_DELAY = 500.0f;
-	float ticks = 0.0f;
-
-	int columnGrid = 0;
-	int rowGrid = 0;
+	const int TOTAL_TEXTURES; //taken from the streaming manifest
+	const int SPAWN_BATCH_SIZE = 30; //icons spawned per frame at most
+	int nextLoadIndex = 0;
+	int inFlightLoads = 0; //main thread only, decremented by the completion continuation
 
 	const int MAX_COLUMN = 28;
 	const int MAX_ROW = 22;
-
-	std::mutex guard;
+	const float ICON_SPACING = 68.0f;
+	const float GRID_OFFSET_X = -65.0f;
+	const float GRID_OFFSET_Y = -100.0f;
 
 	// NEW SEQUENCE FLAGS
 	bool loadingComplete = false;           // Set when all textures loaded
@@ -61,8 +69,9 @@ private:
 
 	bool shouldStartScrolling = false;
 	bool isScrolling = false;
+	bool scrollComplete = false;
 	float scrollTimer = 0.0f;
-	float currentScrollOffset = 0.0f;
+	Camera* worldCamera = nullptr;
 
 	const float SCROLL_DELAY = 2.0f;        // Wait 2 seconds before scrolling
 	const float SCROLL_DURATION = 3.0f;     // Scroll animation takes 3 seconds
@@ -71,6 +80,11 @@ private:
 	void updateScrollAnimation(sf::Time deltaTime);
 
 	void spawnObject();
+	void bakeIconGrid();
+	void resolveFailedUploads();
+	void spawnReadyIcons();
+	void scheduleStreamingLoads();
+	void cancelStreamingLoads();
 	void updateLoadingProgress();
 	void startPokeballAnimation();          // NEW
 	void startBackgroundTransition();        // NEW
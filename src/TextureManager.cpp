@@ -4,15 +4,17 @@
 #include "TextureManager.h"
 #include "StringUtils.h"
 #include "IETThread.h"
+#include "PixelKernels.h"
 
 //a singleton class
 TextureManager* TextureManager::sharedInstance = NULL;
+static std::once_flag sharedInstanceFlag;
 
 TextureManager* TextureManager::getInstance() {
-	if (sharedInstance == NULL) {
-		//initialize
+	//worker threads may be the first to ask for the instance
+	std::call_once(sharedInstanceFlag, [] {
 		sharedInstance = new TextureManager();
-	}
+	});
 
 	return sharedInstance;
 }
@@ -54,54 +56,113 @@ void TextureManager::loadFromAssetList()
 }
 
 void TextureManager::loadSingleStreamAsset(int index)
+{
+	this->queueStreamUpload(this->decodeStreamAsset(index));
+}
+
+TextureManager::DecodedImage TextureManager::decodeStreamAsset(int index)
 {
 	std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 100ms delay per asset
 
-	int fileNum = 0;
+	DecodedImage decoded;
+	decoded.index = index;
 
-	for (const auto& entry : std::filesystem::directory_iterator(STREAMING_PATH)) {
-		if (index == fileNum)
-		{
-			auto filePath = entry.path();
-			std::cout << filePath.filename() << std::endl;
+	if (index < 0 || index >= this->streamingAssetCount) {
+		std::cout << "[TextureManager] Streaming index out of range: " << index << std::endl;
+		return decoded;
+	}
 
-			// Load as image first
-			sf::Image image;
-			if (!image.loadFromFile(filePath.string())) {
-				std::cout << "Failed to load image" << std::endl;
-				break;
-			}
+	const String& filePath = this->streamingManifest.getPath(index);
+	const String& fileName = this->streamingManifest.getFileName(index);
+	std::cout << fileName << std::endl;
+
+	// Load as image first
+	sf::Image image;
+	if (!image.loadFromFile(filePath)) {
+		std::cout << "Failed to load image" << std::endl;
+		this->failedStreamCount.value.fetch_add(1, std::memory_order_relaxed);
+		return decoded;
+	}
+
+	// Resample into an icon-sized pixel buffer. Texture creation needs a GL context, so it is left to processPendingUploads.
+	const sf::Vector2u sourceSize = image.getSize();
+	decoded.name = fileName;
+	decoded.width = this->streamIconSize.x;
+	decoded.height = this->streamIconSize.y;
+	decoded.pixels.resize(static_cast<size_t>(decoded.width) * decoded.height * 4);
+	PixelKernels::resize(image.getPixelsPtr(), sourceSize.x, sourceSize.y, decoded.pixels.data(), decoded.width, decoded.height);
+
+	std::cout << "[TextureManager] Decoded and resized streaming asset at index " << index << std::endl;
+	return decoded;
+}
+
+void TextureManager::queueStreamUpload(DecodedImage decoded)
+{
+	//failed decodes carry no pixels and were already counted
+	if (decoded.pixels.empty()) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(this->uploadMutex);
+	this->pendingUploads.push_back(std::move(decoded));
+}
 
-			// Create a new 256x256 image
-			sf::Image resizedImage;
-			resizedImage.create(256, 256);
+void TextureManager::processPendingUploads()
+{
+	sf::Clock clock;
+	size_t uploadedBytes = 0;
+	int uploadedCount = 0;
 
-			// Copy and scale pixels
-			for (unsigned int y = 0; y < 256; y++) {
-				for (unsigned int x = 0; x < 256; x++) {
-					resizedImage.setPixel(x, y, image.getPixel(x * 2, y * 2));
-				}
+	//always upload at least one image per frame so a tight budget cannot stall loading completely
+	while (uploadedCount == 0 || (clock.getElapsedTime() < this->uploadTimeBudget && uploadedBytes < this->uploadByteBudget))
+	{
+		DecodedImage decoded;
+		{
+			std::lock_guard<std::mutex> lock(this->uploadMutex);
+			if (this->pendingUploads.empty()) {
+				break;
 			}
+			decoded = std::move(this->pendingUploads.front());
+			this->pendingUploads.pop_front();
+		}
 
-			// Create texture from resized image
-			sf::Texture* texture = new sf::Texture();
-			texture->loadFromImage(resizedImage);
+		//a slot that is already filled must not take more atlas space
+		if (this->getStreamTextureFromList(decoded.index) != nullptr) {
+			continue;
+		}
 
-			this->setStreamTextureAtIndex(index, texture);
-			this->textureMap[filePath.filename().string()].push_back(texture);
+		TextureAtlas::Region region;
+		if (!this->streamAtlas.insert(decoded.pixels.data(), decoded.width, decoded.height, region)) {
+			std::cout << "[TextureManager] Failed to pack streaming index " << decoded.index << " into the atlas" << std::endl;
+			this->failedStreamCount.value.fetch_add(1, std::memory_order_relaxed);
 
-			std::cout << "[TextureManager] Loaded and resized streaming texture at index " << index << std::endl;
-			break;
+			//the slot stays empty, so the loader has to hear about it to stop waiting for this index
+			std::lock_guard<std::mutex> lock(this->uploadMutex);
+			this->failedUploads.push_back(decoded.index);
+			continue;
 		}
 
-		fileNum++;
+		this->setStreamRegionAtIndex(decoded.index, region);
+
+		uploadedBytes += decoded.pixels.size();
+		uploadedCount++;
 	}
 }
 
+void TextureManager::setUploadBudget(sf::Time timeBudget, size_t byteBudget)
+{
+	this->uploadTimeBudget = timeBudget;
+	this->uploadByteBudget = byteBudget;
+}
+
 sf::Texture* TextureManager::getFromTextureMap(const String assetName, int frameIndex)
 {
-	if (!this->textureMap[assetName].empty()) {
-		return this->textureMap[assetName][frameIndex];
+	TextureMapShard& shard = this->getTextureMapShard(assetName);
+	std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+	auto found = shard.table.find(assetName);
+	if (found != shard.table.end() && frameIndex >= 0 && frameIndex < found->second.size()) {
+		return found->second[frameIndex];
 	}
 	else {
 		std::cout << "[TextureManager] No texture found for " << assetName << std::endl;
@@ -111,8 +172,12 @@ sf::Texture* TextureManager::getFromTextureMap(const String assetName, int frame
 
 int TextureManager::getNumFrames(const String assetName)
 {
-	if (!this->textureMap[assetName].empty()) {
-		return this->textureMap[assetName].size();
+	TextureMapShard& shard = this->getTextureMapShard(assetName);
+	std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+	auto found = shard.table.find(assetName);
+	if (found != shard.table.end()) {
+		return found->second.size();
 	}
 	else {
 		std::cout << "[TextureManager] No texture found for " << assetName << std::endl;
@@ -122,25 +187,63 @@ int TextureManager::getNumFrames(const String assetName)
 
 sf::Texture* TextureManager::getStreamTextureFromList(const int index)
 {
-	return this->streamTextureList[index];
+	return this->getStreamRegionFromList(index).page;
 }
 
-int TextureManager::getNumLoadedStreamTextures() const
+TextureAtlas::Region TextureManager::getStreamRegionFromList(const int index)
 {
-	int count = 0;
-	for (const auto& texture : this->streamTextureList)
-	{
-		if (texture != nullptr) count++;
+	if (index < 0 || index >= this->streamSlotCount) {
+		return TextureAtlas::Region();
 	}
-	return count;
+
+	TextureAtlas::Region* region = this->streamSlots[index].load(std::memory_order_acquire);
+	return region != nullptr ? *region : TextureAtlas::Region();
+}
+
+int TextureManager::getNumLoadedStreamTextures() const
+{
+	return this->loadedStreamCount.value.load(std::memory_order_acquire);
+}
+
+int TextureManager::getNumFailedStreamTextures() const
+{
+	return this->failedStreamCount.value.load(std::memory_order_acquire);
+}
+
+int TextureManager::getStreamingAssetCount() const
+{
+	return this->streamingAssetCount;
+}
+
+const StreamingManifest& TextureManager::getStreamingManifest() const
+{
+	return this->streamingManifest;
+}
+
+bool TextureManager::writeStreamingManifest()
+{
+	//the existing manifest file must not be the source of the new one
+	this->streamingManifest.build(true);
+	this->streamingAssetCount = this->streamingManifest.size();
+	return this->streamingManifest.writeToFile();
+}
+
+void TextureManager::takeFailedUploads(std::vector<int>& indices)
+{
+	std::lock_guard<std::mutex> lock(this->uploadMutex);
+	indices.insert(indices.end(), this->failedUploads.begin(), this->failedUploads.end());
+	this->failedUploads.clear();
+}
+
+TextureManager::TextureMapShard& TextureManager::getTextureMapShard(const String& assetName)
+{
+	return this->textureMapShards[std::hash<String>()(assetName) % TEXTURE_MAP_SHARD_COUNT];
 }
 
 void TextureManager::countStreamingAssets()
 {
-	this->streamingAssetCount = 0;
-	for (const auto& entry : std::filesystem::directory_iterator(STREAMING_PATH)) {
-		this->streamingAssetCount++;
-	}
+	this->streamingManifest.build();
+	this->streamingAssetCount = this->streamingManifest.size();
 	std::cout << "[TextureManager] Number of streaming assets: " << this->streamingAssetCount << std::endl;
 }
 
@@ -148,12 +251,16 @@ void TextureManager::instantiateAsTexture(String path, String assetName, bool is
 {
 	sf::Texture* texture = new sf::Texture();
 	texture->loadFromFile(path);
-	this->textureMap[assetName].push_back(texture);
+
+	{
+		TextureMapShard& shard = this->getTextureMapShard(assetName);
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		shard.table[assetName].push_back(texture);
+	}
 
 	if (isStreaming)
 	{
-		// this->streamTextureList.push_back(texture);
-		// Texture will be set at specific index via setStreamTextureAtIndex
+		// Streamed assets are packed into the atlas via setStreamRegionAtIndex
 	}
 	else
 	{
@@ -163,14 +270,46 @@ void TextureManager::instantiateAsTexture(String path, String assetName, bool is
 
 void TextureManager::initializeStreamTextureList(int size)
 {
-	this->streamTextureList.resize(size, nullptr);
+	for (int i = 0; i < this->streamSlotCount; i++) {
+		delete this->streamSlots[i].load();
+	}
+
+	this->streamSlots.reset(new std::atomic<TextureAtlas::Region*>[size]);
+	for (int i = 0; i < size; i++) {
+		this->streamSlots[i].store(nullptr, std::memory_order_relaxed);
+	}
+	this->streamSlotCount = size;
+	this->loadedStreamCount.value.store(0);
+	this->failedStreamCount.value.store(0);
 	std::cout << "[TextureManager] Pre-allocated stream texture list for " << size << " textures" << std::endl;
 }
 
-void TextureManager::setStreamTextureAtIndex(int index, sf::Texture* texture)
+void TextureManager::setStreamIconSize(unsigned int width, unsigned int height)
+{
+	this->streamIconSize = sf::Vector2u(width, height);
+}
+
+sf::Vector2u TextureManager::getStreamIconSize() const
+{
+	return this->streamIconSize;
+}
+
+bool TextureManager::setStreamRegionAtIndex(int index, const TextureAtlas::Region& region)
 {
-	if (index >= 0 && index < this->streamTextureList.size())
+	if (index < 0 || index >= this->streamSlotCount)
 	{
-		this->streamTextureList[index] = texture;
+		return false;
 	}
+
+	//a slot is published exactly once; losing the race means another load already filled it
+	TextureAtlas::Region* published = new TextureAtlas::Region(region);
+	TextureAtlas::Region* expected = nullptr;
+	if (!this->streamSlots[index].compare_exchange_strong(expected, published, std::memory_order_acq_rel))
+	{
+		delete published;
+		return false;
+	}
+
+	this->loadedStreamCount.value.fetch_add(1, std::memory_order_release);
+	return true;
 }
\ No newline at end of file
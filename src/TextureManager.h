@@ -1,6 +1,14 @@
 #pragma once
 #include <unordered_map>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include "SFML/Graphics.hpp"
+#include "StreamingManifest.h"
+#include "TextureAtlas.h"
 
 class TextureManager
 {
@@ -8,18 +16,39 @@ public:
 	typedef std::string String;
 	typedef std::vector<sf::Texture*> TextureList;
 	typedef std::unordered_map<String, TextureList> HashTable;
+
+	//CPU-side result of a streaming load, waiting for the main thread to turn it into a texture
+	struct DecodedImage
+	{
+		int index = -1;
+		String name;
+		unsigned int width = 0;
+		unsigned int height = 0;
+		std::vector<sf::Uint8> pixels;
+	};
 	
 public:
 	static TextureManager* getInstance();
 	void loadFromAssetList(); //loading of all assets needed for startup
-	void loadSingleStreamAsset(int index); //loads a single streaming asset based on index in directory
+	void loadSingleStreamAsset(int index); //decodes a single streaming asset based on its index in the streaming manifest and queues it for upload
+	DecodedImage decodeStreamAsset(int index); //load + resample only, safe to call from worker threads. Pixels are empty on failure.
+	void queueStreamUpload(DecodedImage decoded); //hands a decoded asset to the upload stage, callable from any thread
+	void processPendingUploads(); //GL context thread only: uploads decoded assets as textures within the upload budget
+	void setUploadBudget(sf::Time timeBudget, size_t byteBudget);
+	void takeFailedUploads(std::vector<int>& indices); //moves out the indices that decoded but could not be uploaded since the last call
 	sf::Texture* getFromTextureMap(const String assetName, int frameIndex);
 	int getNumFrames(const String assetName);
 
-	sf::Texture* getStreamTextureFromList(const int index);
+	sf::Texture* getStreamTextureFromList(const int index); //atlas page holding the icon, see getStreamRegionFromList for its sub-rect
+	TextureAtlas::Region getStreamRegionFromList(const int index);
 	int getNumLoadedStreamTextures() const;
-	void initializeStreamTextureList(int size);
-	void setStreamTextureAtIndex(int index, sf::Texture* texture);
+	int getNumFailedStreamTextures() const;
+	int getStreamingAssetCount() const;
+	const StreamingManifest& getStreamingManifest() const;
+	bool writeStreamingManifest(); //rescans the streaming directory and regenerates the manifest file from it
+	void initializeStreamTextureList(int size); //must be called before any streaming load is scheduled
+	void setStreamIconSize(unsigned int width, unsigned int height); //size streamed icons are resampled to
+	sf::Vector2u getStreamIconSize() const;
 
 private:
 	TextureManager();
@@ -27,15 +56,46 @@ private:
 	TextureManager& operator=(TextureManager const&) {}; 
 	static TextureManager* sharedInstance;
 
-	HashTable textureMap;
+	//name lookups are split over shards so readers only take a shared lock on one small table
+	struct TextureMapShard
+	{
+		mutable std::shared_mutex mutex;
+		HashTable table;
+	};
+	static const int TEXTURE_MAP_SHARD_COUNT = 16;
+
+	//keeps each counter on its own cache line so workers and the main thread do not false-share
+	struct alignas(64) PaddedCounter
+	{
+		std::atomic<int> value{ 0 };
+	};
+
+	std::array<TextureMapShard, TEXTURE_MAP_SHARD_COUNT> textureMapShards;
 	TextureList baseTextureList;
-	TextureList streamTextureList;
+
+	//one atomic pointer per streaming slot, published once with release ordering
+	std::unique_ptr<std::atomic<TextureAtlas::Region*>[]> streamSlots;
+	int streamSlotCount = 0;
+	PaddedCounter loadedStreamCount;
+	PaddedCounter failedStreamCount;
+	TextureAtlas streamAtlas = TextureAtlas(4096);
 
 	const std::string STREAMING_PATH = "Media/Streaming/";
+	const std::string STREAMING_MANIFEST_PATH = "Media/streaming_manifest.txt";
+	StreamingManifest streamingManifest = StreamingManifest(STREAMING_PATH, STREAMING_MANIFEST_PATH);
 	int streamingAssetCount = 0;
+	sf::Vector2u streamIconSize = sf::Vector2u(256, 256);
+
+	std::deque<DecodedImage> pendingUploads;
+	std::vector<int> failedUploads; //guarded by uploadMutex
+	std::mutex uploadMutex;
+	sf::Time uploadTimeBudget = sf::milliseconds(4);
+	size_t uploadByteBudget = 4 * 1024 * 1024;
 
+	TextureMapShard& getTextureMapShard(const String& assetName);
 	void countStreamingAssets();
 	void instantiateAsTexture(String path, String assetName, bool isStreaming);
+	bool setStreamRegionAtIndex(int index, const TextureAtlas::Region& region); //only called from processPendingUploads
 	
 
 };
\ No newline at end of file
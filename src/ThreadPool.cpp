@@ -1,15 +1,34 @@
 #include "ThreadPool.h"
+#include <random>
 
-ThreadPool::ThreadPool(int _workerCount)
-    : workerCount(_workerCount), isRunning(false)
+namespace
 {
+    // Lets ScheduleTask push onto the caller's own deque when a stealing worker schedules more work
+    thread_local ThreadPool* currentPool = nullptr;
+    thread_local int currentWorkerId = -1;
+}
+
+ThreadPool::ThreadPool(int _workerCount, SchedulingMode _mode)
+    : workerCount(_workerCount), mode(_mode), isRunning(false),
+      stealingRunning(false), queuedTaskCount(0), sleepingWorkerCount(0)
+{
+    if (mode == SchedulingMode::WorkStealing)
+    {
+        for (int i = 0; i < workerCount; i++)
+        {
+            localQueues.push_back(std::make_unique<WorkStealingQueue>());
+        }
+        return;
+    }
+
     workers.resize(workerCount);
+    availableWorkerIds.reserve(workerCount);
 
     // Create and start all worker threads
     for (int i = 0; i < workerCount; i++)
     {
         workers[i] = new WorkerThread(i, this);
-        availableWorkerIds.push(i);
+        availableWorkerIds.push_back(i);
     }
 }
 
@@ -21,12 +40,29 @@ ThreadPool::~ThreadPool()
     {
         delete worker;
     }
+
+    for (auto& queue : localQueues)
+    {
+        queue->Clear();
+    }
+    injectionQueue.Clear();
+    pendingTasks.Clear();
 }
 
 void ThreadPool::StartScheduling()
 {
     isRunning = true;
 
+    if (mode == SchedulingMode::WorkStealing)
+    {
+        stealingRunning = true;
+        for (int i = 0; i < workerCount; i++)
+        {
+            stealingThreads.emplace_back(&ThreadPool::runStealingWorker, this, i);
+        }
+        return;
+    }
+
     // Start all worker threads
     for (auto worker : workers)
     {
@@ -38,6 +74,24 @@ void ThreadPool::StopScheduling()
 {
     isRunning = false;
 
+    if (mode == SchedulingMode::WorkStealing)
+    {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            stealingRunning = false;
+        }
+        idleCv.notify_all();
+
+        for (auto& thread : stealingThreads)
+        {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        stealingThreads.clear();
+        return;
+    }
+
     // Stop all worker threads
     for (auto worker : workers)
     {
@@ -47,9 +101,31 @@ void ThreadPool::StopScheduling()
 
 void ThreadPool::ScheduleTask(IWorkerAction* _task)
 {
+    ScheduleTask(PoolTask([_task] {
+        _task->OnStartTask();
+        delete _task;
+    }));
+}
+
+void ThreadPool::ScheduleTask(PoolTask&& _task)
+{
+    if (mode == SchedulingMode::WorkStealing)
+    {
+        if (currentPool == this && currentWorkerId >= 0) {
+            localQueues[currentWorkerId]->Push(std::move(_task));
+        }
+        else {
+            injectionQueue.Push(std::move(_task));
+        }
+
+        queuedTaskCount.fetch_add(1);
+        wakeStealingWorker();
+        return;
+    }
+
     {
         std::lock_guard<std::mutex> lock(poolMutex);
-        pendingTasks.push(_task);
+        pendingTasks.PushBack(std::move(_task));
     }
 
     processPendingTasks();
@@ -60,15 +136,12 @@ void ThreadPool::processPendingTasks()
     std::lock_guard<std::mutex> lock(poolMutex);
 
     // Assign tasks to available workers
-    while (!pendingTasks.empty() && !availableWorkerIds.empty())
+    while (!pendingTasks.Empty() && !availableWorkerIds.empty())
     {
-        int workerId = availableWorkerIds.front();
-        availableWorkerIds.pop();
-
-        IWorkerAction* task = pendingTasks.front();
-        pendingTasks.pop();
+        int workerId = availableWorkerIds.back();
+        availableWorkerIds.pop_back();
 
-        workers[workerId]->AssignTask(task);
+        workers[workerId]->AssignTask(pendingTasks.PopFront());
     }
 }
 
@@ -76,9 +149,69 @@ void ThreadPool::OnFinishedTask(int id)
 {
     {
         std::lock_guard<std::mutex> lock(poolMutex);
-        availableWorkerIds.push(id);
+        availableWorkerIds.push_back(id);
     }
 
     // Try to process more pending tasks
     processPendingTasks();
-}
\ No newline at end of file
+}
+
+void ThreadPool::runStealingWorker(int id)
+{
+    currentPool = this;
+    currentWorkerId = id;
+
+    while (stealingRunning)
+    {
+        PoolTask task;
+        if (findStealingTask(id, task))
+        {
+            queuedTaskCount.fetch_sub(1);
+            task();
+            task.reset();
+            continue;
+        }
+
+        // Nothing to run anywhere: sleep until a submission bumps the queued count.
+        // Registering as a sleeper before re-checking the count means a concurrent submit cannot be missed.
+        sleepingWorkerCount.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(idleMutex);
+            idleCv.wait(lock, [this] { return queuedTaskCount.load() > 0 || !stealingRunning.load(); });
+        }
+        sleepingWorkerCount.fetch_sub(1);
+    }
+
+    currentPool = nullptr;
+    currentWorkerId = -1;
+}
+
+bool ThreadPool::findStealingTask(int id, PoolTask& _task)
+{
+    // Own deque first, then external submissions, then a sweep of the other workers from a random start
+    if (localQueues[id]->Pop(_task) || injectionQueue.Steal(_task)) {
+        return true;
+    }
+
+    thread_local std::minstd_rand random(std::random_device{}());
+    int start = static_cast<int>(random() % workerCount);
+    for (int i = 0; i < workerCount; i++)
+    {
+        int victim = (start + i) % workerCount;
+        if (victim != id && localQueues[victim]->Steal(_task)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::wakeStealingWorker()
+{
+    // Only touch the idle lock when someone is actually asleep
+    if (sleepingWorkerCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleCv.notify_one();
+    }
+}
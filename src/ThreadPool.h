@@ -1,32 +1,92 @@
 #pragma once
 
 #include "WorkerThread.h"
+#include "WorkStealingQueue.h"
 #include "IWorkerAction.h"
+#include "PoolTask.h"
+#include "TaskRing.h"
+#include "TaskSlab.h"
+#include "TaskFuture.h"
+#include "ITaskExecutor.h"
 
-#include <queue>
+#include <type_traits>
 #include <vector>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
 
-class ThreadPool : public IFinishedTask {
+class ThreadPool : public IFinishedTask, public ITaskExecutor {
 public:
-    ThreadPool(int _workerCount);
+    enum class SchedulingMode {
+        Central,      // one locked queue, idle workers are handed tasks by the pool
+        WorkStealing  // per-worker deques, random-victim stealing and a global injection queue
+    };
+
+    ThreadPool(int _workerCount, SchedulingMode _mode = SchedulingMode::Central);
     ~ThreadPool();
 
     void StartScheduling();
     void StopScheduling();
 
-    void ScheduleTask(IWorkerAction* _task);
+    void ScheduleTask(PoolTask&& _task);
+    void ScheduleTask(IWorkerAction* _task); // compatibility adapter, the pool deletes the action after it runs
+
+    // Any callable. Small captures are stored inline, larger ones in this pool's slab.
+    // The returned future carries the callable's result; chain work onto it with Then().
+    template <class F, class R = std::invoke_result_t<std::decay_t<F>&>>
+    TaskFuture<R> ScheduleTask(F&& _fn)
+    {
+        auto state = std::make_shared<TaskDetail::SharedState<R>>();
+        ScheduleTask(PoolTask([state, fn = std::forward<F>(_fn)]() mutable {
+            TaskDetail::Fulfill(*state, fn);
+        }, &taskSlab));
+        return TaskFuture<R>(state);
+    }
+
+    // Any callable, without a future: nothing is allocated beyond what the slab and queues already hold.
+    // The callable must not throw; join with a counter or similar when the caller needs to wait.
+    template <class F>
+    void ScheduleDetached(F&& _fn)
+    {
+        ScheduleTask(PoolTask(std::forward<F>(_fn), &taskSlab));
+    }
+
+    void Execute(PoolTask&& _task) override { ScheduleTask(std::move(_task)); }
+    TaskSlab* GetTaskSlab() override { return &taskSlab; }
+
+    SchedulingMode GetSchedulingMode() const { return mode; }
+    int GetWorkerCount() const { return workerCount; }
 
 private:
     void OnFinishedTask(int id) override;
 
+    // Declared first so it outlives every queued task that may point into it
+    TaskSlab taskSlab;
+
     int workerCount;
+    SchedulingMode mode;
     std::vector<WorkerThread*> workers;
-    std::queue<int> availableWorkerIds;
-    std::queue<IWorkerAction*> pendingTasks;
+    std::vector<int> availableWorkerIds; // used as a stack; a cycling std::queue keeps allocating blocks
+    TaskRing pendingTasks;
 
     std::mutex poolMutex;
     bool isRunning;
 
     void processPendingTasks();
-};
\ No newline at end of file
+
+    // Work-stealing backend
+    std::vector<std::unique_ptr<WorkStealingQueue>> localQueues;
+    WorkStealingQueue injectionQueue;
+    std::vector<std::thread> stealingThreads;
+    std::atomic<bool> stealingRunning;
+    std::atomic<int> queuedTaskCount;
+    std::atomic<int> sleepingWorkerCount;
+    std::mutex idleMutex;
+    std::condition_variable idleCv;
+
+    void runStealingWorker(int id);
+    bool findStealingTask(int id, PoolTask& _task);
+    void wakeStealingWorker();
+};
@@ -0,0 +1,129 @@
+#include "ThreadPoolBenchmark.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+
+// Counts plain operator new calls so the benchmark can show which scheduling paths reach the heap.
+// Replacing the global operators is program-wide; the cost outside the benchmark is one relaxed increment.
+namespace
+{
+    std::atomic<long long> heapAllocationCount(0);
+}
+
+void* operator new(std::size_t _size)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(_size == 0 ? 1 : _size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _block) noexcept
+{
+    std::free(_block);
+}
+
+void operator delete(void* _block, std::size_t) noexcept
+{
+    std::free(_block);
+}
+
+namespace
+{
+    enum class TaskKind {
+        WorkerAction, // IWorkerAction allocated by the caller
+        Future,       // callable through ScheduleTask, future dropped
+        Detached      // callable through ScheduleDetached
+    };
+
+    const char* taskKindName(TaskKind _kind)
+    {
+        switch (_kind) {
+        case TaskKind::WorkerAction: return "IWorkerAction";
+        case TaskKind::Future: return "future";
+        default: return "detached";
+        }
+    }
+
+    class CountingTask : public IWorkerAction {
+    public:
+        CountingTask(std::atomic<int>* _counter) : counter(_counter) {}
+        void OnStartTask() override { counter->fetch_add(1, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int>* counter;
+    };
+
+    void scheduleAll(ThreadPool& _pool, TaskKind _kind, int _taskCount, std::atomic<int>& _completed)
+    {
+        _completed.store(0);
+        for (int i = 0; i < _taskCount; i++)
+        {
+            std::atomic<int>* completed = &_completed;
+            if (_kind == TaskKind::WorkerAction) {
+                _pool.ScheduleTask(new CountingTask(completed));
+            }
+            else if (_kind == TaskKind::Future) {
+                _pool.ScheduleTask([completed] { completed->fetch_add(1, std::memory_order_relaxed); });
+            }
+            else {
+                _pool.ScheduleDetached([completed] { completed->fetch_add(1, std::memory_order_relaxed); });
+            }
+        }
+        while (_completed.load(std::memory_order_relaxed) < _taskCount)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void measure(const char* _label, int _workerCount, ThreadPool::SchedulingMode _mode, int _taskCount, TaskKind _kind)
+    {
+        std::atomic<int> completed(0);
+        ThreadPool pool(_workerCount, _mode);
+        pool.StartScheduling();
+
+        // the first run grows the queues and the slab; only the second one is the steady state
+        scheduleAll(pool, _kind, _taskCount, completed);
+
+        long long allocationsBefore = heapAllocationCount.load();
+        auto start = std::chrono::steady_clock::now();
+        scheduleAll(pool, _kind, _taskCount, completed);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        long long allocations = heapAllocationCount.load() - allocationsBefore;
+
+        pool.StopScheduling();
+
+        std::cout << "[ThreadPoolBenchmark] " << std::left << std::setw(14) << _label
+            << std::setw(15) << taskKindName(_kind)
+            << std::right << std::setw(4) << _workerCount << " workers "
+            << std::setw(12) << std::fixed << std::setprecision(0) << (_taskCount / seconds) << " tasks/s"
+            << std::setw(10) << allocations << " heap allocations" << std::endl;
+    }
+}
+
+void ThreadPoolBenchmark::Run(int _taskCount)
+{
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (hardwareThreads <= 0) {
+        hardwareThreads = 4;
+    }
+
+    std::cout << "[ThreadPoolBenchmark] " << _taskCount << " empty tasks per run" << std::endl;
+
+    // 30 workers matches TextureDisplay's streaming pool
+    const int workerCounts[] = { hardwareThreads, 30 };
+    for (int workerCount : workerCounts)
+    {
+        for (TaskKind kind : { TaskKind::WorkerAction, TaskKind::Future, TaskKind::Detached })
+        {
+            measure("Central", workerCount, ThreadPool::SchedulingMode::Central, _taskCount, kind);
+            measure("WorkStealing", workerCount, ThreadPool::SchedulingMode::WorkStealing, _taskCount, kind);
+        }
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Throughput of many tiny tasks through each ThreadPool scheduling mode. Run the executable with --bench-pool.
+class ThreadPoolBenchmark {
+public:
+    static void Run(int _taskCount = 200000);
+};
@@ -0,0 +1,146 @@
+#include "TransitionCompositor.h"
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+	//gl_TexCoord[0] is normalized against the "from" texture; the quad-local position is recovered from it
+	//so the "to" image can use its own texture rect
+	const char* TRANSITION_FRAGMENT_SHADER =
+		"uniform sampler2D fromTexture;\n"
+		"uniform sampler2D toTexture;\n"
+		"uniform vec4 fromRect;\n"
+		"uniform vec2 fromSize;\n"
+		"uniform vec4 toRect;\n"
+		"uniform vec2 toSize;\n"
+		"uniform float progress;\n"
+		"uniform int mode;\n"
+		"void main()\n"
+		"{\n"
+		"    vec2 local = (gl_TexCoord[0].xy * fromSize - fromRect.xy) / fromRect.zw;\n"
+		"    vec4 a = texture2D(fromTexture, gl_TexCoord[0].xy);\n"
+		"    vec4 b = texture2D(toTexture, (toRect.xy + local * toRect.zw) / toSize);\n"
+		"    vec4 color;\n"
+		"    if (mode == 0) {\n"
+		"        vec4 white = vec4(1.0);\n"
+		"        color = progress < 0.5 ? mix(a, white, progress * 2.0) : mix(white, b, progress * 2.0 - 1.0);\n"
+		"    } else if (mode == 1) {\n"
+		"        float noise = fract(sin(dot(floor(local * 512.0), vec2(12.9898, 78.233))) * 43758.5453);\n"
+		"        color = noise < progress ? b : a;\n"
+		"    } else {\n"
+		"        color = mix(a, b, smoothstep(local.x - 0.02, local.x + 0.02, progress));\n"
+		"    }\n"
+		"    gl_FragColor = gl_Color * color;\n"
+		"}\n";
+}
+
+void TransitionCompositor::draw(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type)
+{
+	if (from.texture == nullptr || to.texture == nullptr) {
+		return;
+	}
+
+	progress = std::clamp(progress, 0.0f, 1.0f);
+
+	if (this->isShaderAvailable()) {
+		this->drawWithShader(target, from, to, screenRect, progress, type);
+	}
+	else {
+		this->drawFallback(target, from, to, screenRect, progress, type);
+	}
+}
+
+bool TransitionCompositor::isShaderAvailable()
+{
+	//needs a GL context, so it is loaded on first use
+	if (!this->checkedShader) {
+		this->checkedShader = true;
+		this->shaderLoaded = sf::Shader::isAvailable() && this->shader.loadFromMemory(TRANSITION_FRAGMENT_SHADER, sf::Shader::Fragment);
+
+		if (!this->shaderLoaded) {
+			std::cout << "[TransitionCompositor] Shaders unavailable, using the layered fallback" << std::endl;
+		}
+	}
+
+	return this->shaderLoaded;
+}
+
+const char* TransitionCompositor::getTypeName(Type type)
+{
+	switch (type) {
+	case Type::WhiteFade: return "white fade";
+	case Type::Dissolve: return "dissolve";
+	case Type::Wipe: return "wipe";
+	}
+	return "unknown";
+}
+
+void TransitionCompositor::drawWithShader(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type)
+{
+	sf::Vector2u fromSize = from.texture->getSize();
+	sf::Vector2u toSize = to.texture->getSize();
+
+	this->shader.setUniform("fromTexture", sf::Shader::CurrentTexture);
+	this->shader.setUniform("toTexture", *to.texture);
+	this->shader.setUniform("fromRect", sf::Glsl::Vec4(from.textureRect.left, from.textureRect.top, from.textureRect.width, from.textureRect.height));
+	this->shader.setUniform("fromSize", sf::Vector2f(static_cast<float>(fromSize.x), static_cast<float>(fromSize.y)));
+	this->shader.setUniform("toRect", sf::Glsl::Vec4(to.textureRect.left, to.textureRect.top, to.textureRect.width, to.textureRect.height));
+	this->shader.setUniform("toSize", sf::Vector2f(static_cast<float>(toSize.x), static_cast<float>(toSize.y)));
+	this->shader.setUniform("progress", progress);
+	this->shader.setUniform("mode", static_cast<int>(type));
+
+	drawQuad(target, from.texture, screenRect, from.textureRect, sf::Color::White, &this->shader);
+}
+
+void TransitionCompositor::drawFallback(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type)
+{
+	switch (type) {
+	case Type::WhiteFade:
+	{
+		//one image plus a white quad, instead of both images plus the overlay
+		bool firstHalf = progress < 0.5f;
+		const Source& visible = firstHalf ? from : to;
+		float whiteAmount = firstHalf ? progress * 2.0f : 2.0f - progress * 2.0f;
+
+		drawQuad(target, visible.texture, screenRect, visible.textureRect, sf::Color::White);
+		drawQuad(target, nullptr, screenRect, sf::FloatRect(), sf::Color(255, 255, 255, static_cast<sf::Uint8>(whiteAmount * 255.0f)));
+		break;
+	}
+	case Type::Dissolve:
+		//no per-pixel threshold without a shader, so crossfade instead
+		drawQuad(target, from.texture, screenRect, from.textureRect, sf::Color::White);
+		drawQuad(target, to.texture, screenRect, to.textureRect, sf::Color(255, 255, 255, static_cast<sf::Uint8>(progress * 255.0f)));
+		break;
+	case Type::Wipe:
+	{
+		drawQuad(target, from.texture, screenRect, from.textureRect, sf::Color::White);
+
+		sf::FloatRect wipedScreen(screenRect.left, screenRect.top, screenRect.width * progress, screenRect.height);
+		sf::FloatRect wipedTexture(to.textureRect.left, to.textureRect.top, to.textureRect.width * progress, to.textureRect.height);
+		drawQuad(target, to.texture, wipedScreen, wipedTexture, sf::Color::White);
+		break;
+	}
+	}
+}
+
+void TransitionCompositor::drawQuad(sf::RenderTarget& target, const sf::Texture* texture, const sf::FloatRect& screenRect,
+	const sf::FloatRect& textureRect, sf::Color color, const sf::Shader* shader)
+{
+	float right = screenRect.left + screenRect.width;
+	float bottom = screenRect.top + screenRect.height;
+	float u1 = textureRect.left + textureRect.width;
+	float v1 = textureRect.top + textureRect.height;
+
+	sf::Vertex quad[4] =
+	{
+		sf::Vertex(sf::Vector2f(screenRect.left, screenRect.top), color, sf::Vector2f(textureRect.left, textureRect.top)),
+		sf::Vertex(sf::Vector2f(screenRect.left, bottom), color, sf::Vector2f(textureRect.left, v1)),
+		sf::Vertex(sf::Vector2f(right, screenRect.top), color, sf::Vector2f(u1, textureRect.top)),
+		sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1))
+	};
+
+	sf::RenderStates states;
+	states.texture = texture;
+	states.shader = shader;
+	target.draw(quad, 4, sf::TriangleStrip, states);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+/* Blends one full-screen image into another in a single pass. A fragment shader samples both textures and
+ * mixes them according to the transition type and a progress uniform. Without shader support the same
+ * transitions are approximated with at most two textured quads, which is still less overdraw than drawing
+ * both images plus an overlay.
+ */
+class TransitionCompositor : sf::NonCopyable
+{
+public:
+	enum class Type
+	{
+		WhiteFade, //from -> white -> to
+		Dissolve,  //noise threshold
+		Wipe       //left to right with a soft edge
+	};
+
+	struct Source
+	{
+		const sf::Texture* texture = nullptr;
+		sf::FloatRect textureRect; //in pixels, may go past the texture size on repeated textures
+	};
+
+	void draw(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type);
+	bool isShaderAvailable();
+	static const char* getTypeName(Type type); //for logging
+
+private:
+	sf::Shader shader;
+	bool checkedShader = false;
+	bool shaderLoaded = false;
+
+	void drawWithShader(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type);
+	void drawFallback(sf::RenderTarget& target, const Source& from, const Source& to, const sf::FloatRect& screenRect, float progress, Type type);
+	static void drawQuad(sf::RenderTarget& target, const sf::Texture* texture, const sf::FloatRect& screenRect,
+		const sf::FloatRect& textureRect, sf::Color color, const sf::Shader* shader = nullptr);
+};
@@ -0,0 +1,336 @@
+#include "UpdateBenchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "GameObjectManager.h"
+
+namespace
+{
+	const int GROUP_SIZE = 64;
+	const int INTEGRATION_STEPS = 32; //enough work per update that spreading it over threads can pay off
+
+	int destroyedCount = 0; //main thread only, objects are deleted in applyPendingChanges
+	std::atomic<int> nextTicket(0); //hands out the position of every update in a step, across threads
+
+	//a damped spring that only touches its own state, plus bookkeeping for the checks
+	class BenchObject : public AGameObject
+	{
+	public:
+		int updateCount = 0;
+		int* groupCounter = nullptr; //shared by the objects of one group
+		int groupSize = 0;
+		int rankInGroup = 0;
+		bool outOfOrder = false;
+
+		BenchObject(float offset) : AGameObject("BenchObject")
+		{
+			this->offset = offset;
+		}
+
+		~BenchObject()
+		{
+			destroyedCount++;
+		}
+
+		void initialize() override
+		{
+		}
+
+		void processInput(sf::Event event) override
+		{
+		}
+
+		void update(sf::Time deltaTime) override
+		{
+			float dt = deltaTime.asSeconds() / INTEGRATION_STEPS;
+			for (int i = 0; i < INTEGRATION_STEPS; i++) {
+				this->velocity += (-this->offset * 40.0f - this->velocity * 0.5f) * dt;
+				this->offset += this->velocity * dt;
+			}
+
+			//a group is updated by one thread, in the order its objects were added
+			if (this->groupCounter != nullptr) {
+				if (*this->groupCounter != this->updateCount * this->groupSize + this->rankInGroup) {
+					this->outOfOrder = true;
+				}
+				(*this->groupCounter)++;
+			}
+			this->updateCount++;
+		}
+
+	private:
+		float offset;
+		float velocity = 0.0f;
+	};
+
+	//deletes its child from its destructor, like TextureDisplay does with its helper objects
+	class OwnerObject : public BenchObject
+	{
+	public:
+		BenchObject* child = nullptr;
+
+		OwnerObject() : BenchObject(0.0f)
+		{
+		}
+
+		~OwnerObject()
+		{
+			GameObjectManager::getInstance()->deleteObject(this->child);
+		}
+	};
+
+	//remembers when in the step it was updated
+	class OrderObject : public AGameObject
+	{
+	public:
+		int addIndex;
+		int ticket = -1;
+		int updateCount = 0;
+
+		OrderObject(int addIndex) : AGameObject("OrderObject")
+		{
+			this->addIndex = addIndex;
+		}
+
+		void initialize() override
+		{
+		}
+
+		void processInput(sf::Event event) override
+		{
+		}
+
+		void update(sf::Time deltaTime) override
+		{
+			this->ticket = nextTicket.fetch_add(1);
+			this->updateCount++;
+		}
+	};
+
+	//every deferred delete has to reach the derived destructor, also for deletes queued by a destructor
+	void checkDeletion()
+	{
+		GameObjectManager* manager = GameObjectManager::getInstance();
+		destroyedCount = 0;
+
+		OwnerObject* owner = new OwnerObject();
+		owner->child = new BenchObject(0.0f);
+		manager->addObject(owner);
+		manager->addObject(owner->child);
+		manager->applyPendingChanges();
+
+		ObjectHandle childHandle = owner->child->getHandle();
+		manager->deleteObject(owner);
+		manager->applyPendingChanges();
+
+		bool passed = destroyedCount == 2 && manager->getObject(childHandle) == NULL;
+		std::cout << "[UpdateBenchmark] " << std::left << std::setw(22) << "deletion"
+			<< (passed ? "ok" : "ERROR: a derived destructor did not run") << std::endl;
+	}
+
+	//checks the order documented at AGameObject::setThreadSafeUpdate, on the main-thread path and on the pool.
+	//some objects are deleted first, removal reorders the manager's list
+	void checkOrder(const char* label, bool usePool)
+	{
+		const int OBJECT_COUNT = 600;
+		const int ORDER_GROUPS = 4;
+		GameObjectManager* manager = GameObjectManager::getInstance();
+		int threshold = manager->getParallelUpdateThreshold();
+		manager->setParallelUpdateThreshold(usePool ? 0 : INT_MAX);
+
+		std::vector<OrderObject*> objects;
+		for (int i = 0; i < OBJECT_COUNT; i++) {
+			OrderObject* object = new OrderObject(i);
+			if (i % 3 == 1) {
+				object->setThreadSafeUpdate(true);
+			}
+			else if (i % 3 == 2) {
+				object->setUpdateGroup(i / 3 % ORDER_GROUPS + 1);
+			}
+			manager->addObject(object);
+			objects.push_back(object);
+		}
+		manager->applyPendingChanges();
+
+		std::vector<OrderObject*> remaining;
+		for (OrderObject* object : objects) {
+			if (object->addIndex % 5 == 0) {
+				manager->deleteObject(object);
+			}
+			else {
+				remaining.push_back(object);
+			}
+		}
+		manager->applyPendingChanges();
+
+		nextTicket = 0;
+		manager->update(sf::seconds(1.0f / 60.0f));
+		bool pooled = manager->getParallelUpdateCount() > 0;
+
+		int lastOptedIn = -1;
+		int firstSerial = INT_MAX;
+		int lastSerial = -1;
+		std::vector<int> lastInGroup(ORDER_GROUPS + 1, -1);
+		int errors = 0;
+		for (OrderObject* object : remaining) {
+			if (object->updateCount != 1) {
+				errors++;
+			}
+			else if (object->getUpdateGroup() != 0) {
+				int& last = lastInGroup[object->getUpdateGroup()];
+				if (object->ticket < last) errors++;
+				last = object->ticket;
+				lastOptedIn = std::max(lastOptedIn, object->ticket);
+			}
+			else if (object->isThreadSafeUpdate()) {
+				lastOptedIn = std::max(lastOptedIn, object->ticket);
+			}
+			else {
+				if (object->ticket < lastSerial) errors++;
+				lastSerial = object->ticket;
+				firstSerial = std::min(firstSerial, object->ticket);
+			}
+		}
+		if (lastOptedIn > firstSerial) errors++;
+
+		std::cout << "[UpdateBenchmark] " << std::left << std::setw(22) << label;
+		if (pooled != usePool) {
+			std::cout << "ERROR: the " << (usePool ? "pool" : "main thread") << " was not used" << std::endl;
+		}
+		else if (errors > 0) {
+			std::cout << "ERROR: " << errors << " objects updated out of order or not exactly once" << std::endl;
+		}
+		else {
+			std::cout << "ok" << std::endl;
+		}
+
+		for (OrderObject* object : remaining) {
+			manager->deleteObject(object);
+		}
+		manager->applyPendingChanges();
+		manager->setParallelUpdateThreshold(threshold);
+	}
+
+	//ms per step for thread-safe objects with the given threshold
+	double timeThreadSafe(int objectCount, int steps, int threshold)
+	{
+		GameObjectManager* manager = GameObjectManager::getInstance();
+		manager->setParallelUpdateThreshold(threshold);
+
+		std::vector<BenchObject*> objects;
+		for (int i = 0; i < objectCount; i++) {
+			BenchObject* object = new BenchObject(static_cast<float>(i % 100));
+			object->setThreadSafeUpdate(true);
+			manager->addObject(object);
+			objects.push_back(object);
+		}
+		manager->applyPendingChanges();
+
+		sf::Time step = sf::seconds(1.0f / 60.0f);
+		manager->update(step); //starts the pool
+		sf::Clock clock;
+		for (int i = 0; i < steps; i++) {
+			manager->update(step);
+		}
+		double ms = clock.getElapsedTime().asMicroseconds() / 1000.0 / steps;
+
+		for (BenchObject* object : objects) {
+			manager->deleteObject(object);
+		}
+		manager->applyPendingChanges();
+		return ms;
+	}
+
+	//the same objects on the main thread and on the pool, around the default threshold
+	void sweepThreshold(int steps)
+	{
+		GameObjectManager* manager = GameObjectManager::getInstance();
+		int threshold = manager->getParallelUpdateThreshold();
+
+		const int counts[] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+		for (int count : counts) {
+			double mainThread = timeThreadSafe(count, steps, INT_MAX);
+			double pool = timeThreadSafe(count, steps, 0);
+			std::cout << "[UpdateBenchmark] threshold sweep" << std::right << std::setw(7) << count << " objects"
+				<< std::setw(9) << std::fixed << std::setprecision(3) << mainThread << " ms main thread"
+				<< std::setw(9) << pool << " ms pool" << (count >= threshold ? "   (pool by default)" : "") << std::endl;
+		}
+
+		manager->setParallelUpdateThreshold(threshold);
+	}
+
+	void runCase(const char* label, int objectCount, int steps, bool threadSafe, bool grouped)
+	{
+		GameObjectManager* manager = GameObjectManager::getInstance();
+
+		std::vector<int> groupCounters(grouped ? (objectCount + GROUP_SIZE - 1) / GROUP_SIZE : 0, 0);
+		std::vector<BenchObject*> objects;
+		objects.reserve(objectCount);
+		for (int i = 0; i < objectCount; i++) {
+			BenchObject* object = new BenchObject(static_cast<float>(i % 100));
+			object->setThreadSafeUpdate(threadSafe);
+			if (grouped) {
+				int group = i / GROUP_SIZE;
+				object->setUpdateGroup(group + 1);
+				object->groupCounter = &groupCounters[group];
+				object->groupSize = std::min(GROUP_SIZE, objectCount - group * GROUP_SIZE);
+				object->rankInGroup = i % GROUP_SIZE;
+			}
+			manager->addObject(object);
+			objects.push_back(object);
+		}
+		manager->applyPendingChanges();
+
+		sf::Time step = sf::seconds(1.0f / 60.0f);
+		sf::Clock clock;
+		for (int i = 0; i < steps; i++) {
+			manager->update(step);
+		}
+		sf::Time total = clock.getElapsedTime();
+		int parallelCount = manager->getParallelUpdateCount();
+
+		int wrongCounts = 0;
+		int outOfOrder = 0;
+		for (BenchObject* object : objects) {
+			if (object->updateCount != steps) wrongCounts++;
+			if (object->outOfOrder) outOfOrder++;
+		}
+
+		std::cout << "[UpdateBenchmark] " << std::left << std::setw(22) << label
+			<< std::right << std::setw(9) << std::fixed << std::setprecision(3)
+			<< (total.asMicroseconds() / 1000.0 / steps) << " ms/step"
+			<< std::setw(8) << parallelCount << " on workers";
+		if (wrongCounts > 0 || outOfOrder > 0) {
+			std::cout << "  ERROR: " << wrongCounts << " objects missed or repeated an update, "
+				<< outOfOrder << " updated out of group order";
+		}
+		std::cout << std::endl;
+
+		destroyedCount = 0;
+		for (BenchObject* object : objects) {
+			manager->deleteObject(object);
+		}
+		manager->applyPendingChanges();
+		if (destroyedCount != objectCount) {
+			std::cout << "[UpdateBenchmark] ERROR: " << objectCount - destroyedCount << " objects were not destroyed" << std::endl;
+		}
+	}
+}
+
+void UpdateBenchmark::run(int objectCount, int steps)
+{
+	std::cout << "[UpdateBenchmark] " << objectCount << " objects, " << steps << " steps, groups of " << GROUP_SIZE << std::endl;
+
+	checkDeletion();
+	checkOrder("order, main thread", false);
+	checkOrder("order, pool", true);
+	runCase("serial", objectCount, steps, false, false);
+	runCase("thread-safe", objectCount, steps, true, false);
+	runCase("thread-safe, grouped", objectCount, steps, true, true);
+	sweepThreshold(steps);
+
+	GameObjectManager::getInstance()->shutdown();
+}
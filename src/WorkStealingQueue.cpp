@@ -0,0 +1,35 @@
+#include "WorkStealingQueue.h"
+
+void WorkStealingQueue::Push(PoolTask&& _task)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    tasks.PushBack(std::move(_task));
+}
+
+bool WorkStealingQueue::Pop(PoolTask& _task)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (tasks.Empty()) {
+        return false;
+    }
+
+    _task = tasks.PopBack();
+    return true;
+}
+
+bool WorkStealingQueue::Steal(PoolTask& _task)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (tasks.Empty()) {
+        return false;
+    }
+
+    _task = tasks.PopFront();
+    return true;
+}
+
+void WorkStealingQueue::Clear()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    tasks.Clear();
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "TaskRing.h"
+#include <mutex>
+
+// Per-worker task deque. The owning worker pushes and pops at the back (LIFO, cache friendly),
+// thieves take from the front so they grab the oldest work.
+class WorkStealingQueue {
+public:
+    void Push(PoolTask&& _task);
+    bool Pop(PoolTask& _task);
+    bool Steal(PoolTask& _task);
+    void Clear(); // drops any tasks that never ran
+
+private:
+    std::mutex queueMutex;
+    TaskRing tasks;
+};
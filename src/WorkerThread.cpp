@@ -1,7 +1,7 @@
 #include "WorkerThread.h"
 
 WorkerThread::WorkerThread(int _id, IFinishedTask* _onDone)
-    : id(_id), onDone(_onDone), task(nullptr), running(false), hasTask(false)
+    : id(_id), onDone(_onDone), running(false), hasTask(false)
 {
 }
 
@@ -25,11 +25,11 @@ void WorkerThread::Stop()
     }
 }
 
-void WorkerThread::AssignTask(IWorkerAction* _task)
+void WorkerThread::AssignTask(PoolTask&& _task)
 {
     {
         std::lock_guard<std::mutex> lock(taskMutex);
-        task = _task;
+        task = std::move(_task);
         hasTask = true;
     }
     cv.notify_one();
@@ -39,7 +39,7 @@ void WorkerThread::run()
 {
     while (running)
     {
-        IWorkerAction* currentTask = nullptr;
+        PoolTask currentTask;
 
         {
             std::unique_lock<std::mutex> lock(taskMutex);
@@ -48,16 +48,15 @@ void WorkerThread::run()
             if (!running) break;
 
             if (hasTask) {
-                currentTask = task;
-                task = nullptr;
+                currentTask = std::move(task);
                 hasTask = false;
             }
         }
 
-        if (currentTask != nullptr)
+        if (currentTask)
         {
-            currentTask->OnStartTask();
-            delete currentTask;  // Clean up the task after execution
+            currentTask();
+            currentTask.reset();  // Release the captures before reporting back
 
             if (onDone != nullptr)
             {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "IWorkerAction.h"
+#include "PoolTask.h"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -17,7 +17,7 @@ public:
     ~WorkerThread();
 
     void Start();  // Start the worker thread (call once)
-    void AssignTask(IWorkerAction* _task);
+    void AssignTask(PoolTask&& _task);
     void Stop();   // Stop the worker thread
     int GetId() { return id; }
 
@@ -26,7 +26,7 @@ private:
 
     int id;
     IFinishedTask* onDone;
-    IWorkerAction* task;
+    PoolTask task;
 
     std::thread workerThread;
     std::mutex taskMutex;
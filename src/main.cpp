@@ -1,6 +1,52 @@
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 #include "BaseRunner.h"
-int main() {
-	BaseRunner runner;
+#include "TextureManager.h"
+#include "PixelKernelBenchmark.h"
+#include "ThreadPoolBenchmark.h"
+#include "SpriteBatchBenchmark.h"
+#include "UpdateBenchmark.h"
+
+int main(int argc, char** argv) {
+	bool useRenderThread = false;
+	FramePacer::LimitMode limitMode = FramePacer::LimitMode::None;
+	unsigned int frameLimit = 60;
+	for (int i = 1; i < argc; i++) {
+		//regenerates Media/streaming_manifest.txt from the streaming directory
+		if (std::strcmp(argv[i], "--write-streaming-manifest") == 0) {
+			return TextureManager::getInstance()->writeStreamingManifest() ? 0 : 1;
+		}
+		if (std::strcmp(argv[i], "--bench-resize") == 0) {
+			PixelKernelBenchmark::run();
+			return 0;
+		}
+		if (std::strcmp(argv[i], "--bench-pool") == 0) {
+			ThreadPoolBenchmark::Run();
+			return 0;
+		}
+		if (std::strcmp(argv[i], "--bench-batch") == 0) {
+			SpriteBatchBenchmark::run();
+			return 0;
+		}
+		if (std::strcmp(argv[i], "--bench-update") == 0) {
+			UpdateBenchmark::run();
+			return 0;
+		}
+		if (std::strcmp(argv[i], "--render-thread") == 0) {
+			useRenderThread = true;
+		}
+		if (std::strcmp(argv[i], "--vsync") == 0) {
+			limitMode = FramePacer::LimitMode::VSync;
+		}
+		//sleeps away the rest of each frame, e.g. --frame-limit 144
+		if (std::strcmp(argv[i], "--frame-limit") == 0 && i + 1 < argc) {
+			limitMode = FramePacer::LimitMode::Sleep;
+			frameLimit = static_cast<unsigned int>(std::atoi(argv[++i]));
+		}
+	}
+
+	BaseRunner runner(useRenderThread);
+	runner.setFrameLimit(limitMode, frameLimit);
 	runner.run();
-}
\ No newline at end of file
+}